@@ -1,17 +1,24 @@
+#include <algorithm>
+#include <atomic>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <iterator>
 #include <memory>
+#include <optional>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "ast/ast.hpp"
+#include "ast/astSerializer.hpp"
 #include "ast/populateMethodPass.hpp"
 #include "parseTree/parseTree.hpp"
+#include "parseTree/parseTreeCache.hpp"
 #include "parseTree/parseTreeVisitor.hpp"
+#include "parseTree/sourceFile.hpp"
 #include "parseTree/sourceNode.hpp"
 #include "parser/myBisonParser.hpp"
 #include "staticCheck/astValidator.hpp"
@@ -33,6 +40,7 @@
 #include "codeGen/exprIRConverter.hpp"
 #include "codeGen/registerAllocator/basicAllocator.hpp"
 #include "tir/TIRBuilder.hpp"
+#include "utils/timeReport.hpp"
 
 #include <filesystem>
 #include <memory>
@@ -42,238 +50,426 @@
 
 namespace fs = std::filesystem;
 
-// hack
-bool isLiteralTypeValid(const std::shared_ptr<parsetree::Node> &node) {
-  if (!node)
-    return true;
-
-  if (node->get_node_type() == parsetree::Node::Type::Literal) {
-    auto literalNode = std::dynamic_pointer_cast<parsetree::Literal>(node);
-    return literalNode && literalNode->isValid();
-  }
-
-  return std::all_of(
-      node->children().begin(), node->children().end(),
-      [](const auto &child) { return isLiteralTypeValid(child); });
-}
+// Result of the per-file front end (read, parse, build AST)
+struct FrontEndResult {
+  int exitCode = EXIT_SUCCESS;
+  std::string diagnostics; // printed to stderr when results are merged
+  // bison's message, printed with line and column once lineStarts is in
+  // the SourceManager
+  std::string syntaxError;
+  source::SourceRange syntaxErrorLoc;
+  uint64_t contentHash = 0;
+  std::vector<uint32_t> lineStarts;
+  std::shared_ptr<parsetree::Node> parseTree;
+  std::shared_ptr<parsetree::ast::ProgramDecl> ast;
+};
+
+// Files are independent until type linking, so this runs on worker threads
+// with -j. Diagnostics are buffered so they come out in argv order.
+FrontEndResult runFrontEnd(const std::string &filePath, int fileID,
+                           const parsetree::ParseTreeCache &libCache,
+                           bool keepParseTree) {
+  utils::TimeReport::Scope unit{"front end", filePath};
+  FrontEndResult result;
+  std::ostringstream err;
+  auto fail = [&](int exitCode) {
+    result.exitCode = exitCode;
+    result.diagnostics = err.str();
+    return result;
+  };
 
-int main(int argc, char **argv) {
-  int retCode = EXIT_SUCCESS;
   try {
-    if (argc == 1) {
-      std::cerr << "Usage: " << argv[0] << " input-files... " << std::endl;
-      return EXIT_FAILURE;
+    // Extract file path and validate extension
+    const std::string fileName =
+        std::filesystem::path(filePath).stem().string();
+    if (!filePath.ends_with(".java")) {
+      err << "Error: not a valid .java file" << std::endl;
+      return fail(EXIT_ERROR);
     }
 
-    source::SourceManager sm = source::SourceManager();
-    auto astManager = std::make_shared<parsetree::ast::ASTManager>();
-    auto env = std::make_shared<static_check::EnvManager>();
-
-    std::cout << "Starting compilation..." << std::endl;
-
-    // First pass: AST construction
-    for (int file_number = 1; file_number < argc; ++file_number) {
-      // Extract file path and validate extension
-      const std::string filePath = argv[file_number];
-      const std::string fileName =
-          std::filesystem::path(filePath).stem().string();
-      if (!filePath.ends_with(".java")) {
-        std::cerr << "Error: not a valid .java file" << std::endl;
-        return EXIT_ERROR;
-      }
+    // Map file content, the lexer reads it in place
+    source::MappedFile inputFile(filePath);
+    if (!inputFile.is_open()) {
+      err << "Error! Could not open input file \"" << filePath << "\""
+          << std::endl;
+      return fail(EXIT_FAILURE);
+    }
+    const std::string_view fileContent = inputFile.contents();
 
-      // Track file
-      sm.addFile(fileName);
+    // Check for non-ASCII characters, indexing lines on the same pass
+    if (!source::scanSource(fileContent, result.lineStarts)) {
+      err << "Parse error: non-ASCII character in input" << std::endl;
+      return fail(EXIT_ERROR);
+    }
 
-      // Read file content
-      std::ifstream inputFile(filePath, std::ios::binary);
-      if (!inputFile.is_open()) {
-        std::cerr << "Error! Could not open input file \"" << filePath << "\""
-                  << std::endl;
-        return EXIT_FAILURE;
-      }
-      const std::string fileContent((std::istreambuf_iterator<char>(inputFile)),
-                                    std::istreambuf_iterator<char>());
-
-      // Check for non-ASCII characters
-      if (std::any_of(fileContent.begin(), fileContent.end(), [](char c) {
-            return static_cast<unsigned char>(c) > 127;
-          })) {
-        std::cerr << "Parse error: non-ASCII character in input" << std::endl;
-        return EXIT_ERROR;
-      }
+    // Cached trees were already validated when the cache was emitted
+    result.contentHash = parsetree::ParseTreeCache::hashContent(fileContent);
+    std::shared_ptr<parsetree::Node> parse_tree =
+        libCache.lookup(filePath, result.contentHash, fileID);
 
+    if (!parse_tree) {
       // Parse the input
-      std::shared_ptr<parsetree::Node> parse_tree;
       myBisonParser parser{fileContent};
-      parser.setFileID(file_number);
-      int result = parser.parse(parse_tree);
+      parser.setFileID(fileID);
+      int parseResult = parser.parse(parse_tree);
 
       // Validate parse result
-      if (!parse_tree || result) {
-        std::cerr << "Parse error: parse failed" << std::endl;
-        return EXIT_ERROR;
+      if (parser.hasInvalidConstruct()) {
+        err << "Parse error: parse tree is invalid" << std::endl;
+        return fail(EXIT_ERROR);
       }
-      if (parse_tree->is_corrupted()) {
-        std::cerr << "Parse error: parse tree is invalid" << std::endl;
-        // comment out if not debugging
-        // parse_tree->print(std::cerr);
-        return EXIT_ERROR;
+      if (!parse_tree || parseResult) {
+        result.syntaxError = parser.getSyntaxError();
+        result.syntaxErrorLoc = parser.getSyntaxErrorLoc();
+        err << "Parse error: parse failed" << std::endl;
+        return fail(EXIT_ERROR);
       }
+    }
+    // Only kept around for --emit-lib-cache, otherwise the whole tree (and
+    // its arena) goes away as soon as the AST is built
+    if (keepParseTree)
+      result.parseTree = parse_tree;
+
+    // if (fileID == 1)
+    //   parse_tree->print(std::cout);
+
+    // Build AST from the parse tree. The env only holds per-class/per-method
+    // scope state, so each file gets its own.
+    std::shared_ptr<parsetree::ast::ProgramDecl> ast;
+    parsetree::ParseTreeVisitor visitor{
+        std::make_shared<static_check::EnvManager>()};
+    try {
+      ast = visitor.visitProgramDecl(parse_tree);
+    } catch (const std::exception &ex) {
+      err << "Runtime error: " << ex.what() << std::endl;
+      return fail(EXIT_ERROR);
+    } catch (...) {
+      err << "Unknown failure occurred." << std::endl;
+      return fail(EXIT_FAILURE);
+    }
 
-      // Validate literal types
-      if (!isLiteralTypeValid(parse_tree)) {
-        std::cerr << "Parse error: invalid literal type" << std::endl;
-        return EXIT_ERROR;
-      }
+    if (!ast) {
+      err << "Parse error: failed to build AST" << std::endl;
+      return fail(EXIT_ERROR);
+    }
 
-      // if (file_number == 1)
-      //   parse_tree->print(std::cout);
-
-      // Build AST from the parse tree
-      std::shared_ptr<parsetree::ast::ProgramDecl> ast;
-      parsetree::ParseTreeVisitor visitor{env};
-      try {
-        if (parse_tree->is_corrupted())
-          throw std::runtime_error("Parse tree is invalid");
-        ast = visitor.visitProgramDecl(parse_tree);
-      } catch (const std::exception &ex) {
-        std::cerr << "Runtime error: " << ex.what() << std::endl;
-        return EXIT_ERROR;
-      } catch (...) {
-        std::cerr << "Unknown failure occurred." << std::endl;
-        return EXIT_FAILURE;
-      }
+    // Validate class/interface name matches file name
+    const auto body =
+        std::dynamic_pointer_cast<parsetree::ast::Decl>(ast->getBody());
+    if (!body || body->getName() != fileName) {
+      err << "Parse error: class/interface name does not match file name"
+          << std::endl;
+      err << "Class/interface name: " << (body ? body->getName() : "<null>")
+          << std::endl;
+      err << "File name: " << fileName << std::endl;
+      return fail(EXIT_ERROR);
+    }
+    result.ast = ast;
+    // std::cout << "Parsed " << fileName << std::endl;
+  } catch (const std::runtime_error &ex) {
+    err << "Runtime error: " << ex.what() << std::endl;
+    return fail(EXIT_ERROR);
+  } catch (const std::exception &ex) {
+    err << "Unhandled exception: " << ex.what() << std::endl;
+    return fail(EXIT_FAILURE);
+  }
+  return result;
+}
 
-      if (!ast) {
-        std::cerr << "Parse error: failed to build AST" << std::endl;
-        return EXIT_ERROR;
-      }
+// Everything up to codegen: parse every file, link and check the whole
+// program into astManager. Returns EXIT_SUCCESS if it is ready for codegen.
+int checkProgram(const std::vector<std::string> &inputFiles, unsigned numJobs,
+                 const std::string &useLibCache,
+                 const std::string &emitLibCache,
+                 std::shared_ptr<parsetree::ast::ASTManager> astManager) {
+  source::SourceManager sm = source::SourceManager();
+  auto env = std::make_shared<static_check::EnvManager>();
+
+  // Parse tree cache for files that don't change between runs (stdlib)
+  parsetree::ParseTreeCache libCache;
+  if (!useLibCache.empty() && !libCache.load(useLibCache)) {
+    std::cerr << "Warning: could not load lib cache " << useLibCache
+              << ", parsing all files" << std::endl;
+  }
 
-      // Validate class/interface name matches file name
-      const auto body =
-          std::dynamic_pointer_cast<parsetree::ast::Decl>(ast->getBody());
-      if (!body || body->getName() != fileName) {
-        std::cerr
-            << "Parse error: class/interface name does not match file name"
-            << std::endl;
-        std::cerr << "Class/interface name: "
-                  << (body ? body->getName() : "<null>") << std::endl;
-        std::cerr << "File name: " << fileName << std::endl;
-        return EXIT_ERROR;
+  std::cout << "Starting compilation..." << std::endl;
+
+  // Track files
+  std::vector<int> fileIDs;
+  for (auto &filePath : inputFiles) {
+    fileIDs.push_back(
+        sm.addFile(std::filesystem::path(filePath).stem().string()));
+  }
+
+  // First pass: AST construction
+  utils::TimeReport::Scope frontEndPhase{"front end"};
+  std::vector<FrontEndResult> results(inputFiles.size());
+  auto mergeResult = [&](size_t i) {
+    auto &result = results[i];
+    sm.setLineStarts(fileIDs[i], std::move(result.lineStarts));
+    if (!result.syntaxError.empty()) {
+      std::cerr << "Parsing error! : " << result.syntaxError << "\n";
+      sm.printRange(std::cerr, result.syntaxErrorLoc);
+    }
+    std::cerr << result.diagnostics;
+    if (result.exitCode != EXIT_SUCCESS)
+      return false;
+    if (!emitLibCache.empty())
+      libCache.insert(inputFiles[i], result.contentHash, result.parseTree);
+    astManager->addAST(result.ast);
+    result = FrontEndResult{};
+    return true;
+  };
+
+  if (numJobs <= 1 || inputFiles.size() <= 1) {
+    for (size_t i = 0; i < inputFiles.size(); ++i) {
+      results[i] = runFrontEnd(inputFiles[i], fileIDs[i], libCache,
+                               !emitLibCache.empty());
+      if (!mergeResult(i))
+        return results[i].exitCode;
+    }
+  } else {
+    // Workers grab files in order; once a file fails, files after it are
+    // skipped since the serial path would never have reached them
+    std::atomic<size_t> nextFile = 0;
+    std::atomic<size_t> firstFailure = inputFiles.size();
+    auto worker = [&]() {
+      for (size_t i = nextFile++; i < inputFiles.size(); i = nextFile++) {
+        if (i > firstFailure)
+          continue;
+        results[i] = runFrontEnd(inputFiles[i], fileIDs[i], libCache,
+                                 !emitLibCache.empty());
+        if (results[i].exitCode != EXIT_SUCCESS) {
+          size_t expected = firstFailure;
+          while (i < expected &&
+                 !firstFailure.compare_exchange_weak(expected, i))
+            ;
+        }
       }
-      astManager->addAST(ast);
-      // std::cout << "Parsed " << fileName << std::endl;
+    };
+    std::vector<std::thread> workers;
+    for (unsigned j = 0; j < std::min<size_t>(numJobs, inputFiles.size());
+         ++j) {
+      workers.emplace_back(worker);
+    }
+    for (auto &thread : workers) {
+      thread.join();
     }
 
-    std::cout << "Passed AST constructions\n";
-
-    // environment (symbol table) building + type linking
-    auto typeLinker =
-        std::make_shared<static_check::TypeLinker>(astManager, env);
-    std::shared_ptr<static_check::Package> rootPackage =
-        typeLinker->getRootPackage();
-    // rootPackage->printStructure();
-    std::cout << "Starting type linking\n";
-    typeLinker->resolve();
-    std::cout << "Populating java.lang\n";
-    typeLinker->populateJavaLang();
-    std::cout << "Passed type linking\n";
-
-    if (astManager->allDecls.size() != astManager->getASTs().size()) {
-      std::cerr
-          << "Mismatch from number of ASTs to number of classes/interfaces"
-          << std::endl;
-      std::cerr << "Number of classes/interfaces: "
-                << astManager->allDecls.size() << ", ";
-      std::cerr << "Number of ASTs: " << astManager->getASTs().size()
-                << std::endl;
-      return EXIT_ERROR;
+    // Merge in argv order so diagnostics and exit codes match the serial
+    // path
+    for (size_t i = 0; i < inputFiles.size(); ++i) {
+      if (!mergeResult(i))
+        return results[i].exitCode;
     }
+  }
 
-    // astManager->getASTs()[2]->print(std::cout);
+  frontEndPhase.stop();
+  std::cout << "Passed AST constructions\n";
 
-    auto populateMethodPass =
-        parsetree::ast::PopulateMethodPass(astManager, typeLinker);
-    populateMethodPass.populate();
+  if (!emitLibCache.empty()) {
+    libCache.save(emitLibCache);
+    std::cout << "Wrote lib cache " << emitLibCache << " ("
+              << libCache.size() << " files)\n";
+  }
 
-    // hierarchy checking
-    auto hierarchyChecker =
-        std::make_shared<static_check::HierarchyCheck>(rootPackage);
-    std::cout << "Starting hierarchy check" << std::endl;
-    if (!hierarchyChecker->check()) {
-      std::cout << "Did not pass hierarchy check\n";
-      return EXIT_ERROR;
-    }
-    std::cout << "Passed hierarchy check\n";
-
-    // for (auto &ast : astManager->getASTs()) {
-    //   checkLinked(ast);
-    // }
-
-    std::cout << "Starting name disambiguation and type checking...\n";
-
-    astManager->getASTs()[0]->print(std::cout);
-
-    auto typeResolver =
-        std::make_shared<static_check::TypeResolver>(astManager, env);
-
-    auto exprResolver = std::make_shared<static_check::ExprResolver>(
-        astManager, hierarchyChecker, typeLinker, typeResolver);
-    exprResolver->resolve();
-
-    auto astValidator =
-        std::make_shared<static_check::ASTValidator>(typeResolver);
-    astValidator->validate(astManager);
-
-    auto forwardChecker = std::make_shared<static_check::ForwardChecker>();
-    forwardChecker->check(astManager);
-
-    std::cout << "Name disambiguation and type checking passed\n";
-
-    auto cfgBuilder = std::make_shared<static_check::CFGBuilder>();
-    std::cout << "Start building CFGs....\n";
-    for (auto ast : astManager->getASTs()) {
-      for (auto decl : ast->getBody()->getDecls()) {
-        if (auto method =
-                std::dynamic_pointer_cast<parsetree::ast::MethodDecl>(decl)) {
-          // std::cout << "=== Start building CFG for method " <<
-          // method->getName()
-          //           << " ===" << std::endl;
-          std::shared_ptr<CFG> cfg = cfgBuilder->buildCFG(method);
-          // std::cout << "=== Done building CFG for method " <<
-          // method->getName()
-          //           << " ===" << std::endl;
-          if (cfg) {
-            // cfg->print(std::cout);
-            if (!static_check::ReachabilityAnalysis::checkUnreachableStatements(
-                    cfg)) {
-              std::cerr << "Method " << method->getName()
-                        << " has unreachable statements" << std::endl;
-              return EXIT_ERROR;
-            }
-            if (!static_check::ReachabilityAnalysis::checkFiniteLengthReturn(
-                    cfg, method)) {
-              std::cerr
-                  << "Method " << method->getName()
-                  << " finite-length execution paths do not all end in return"
-                  << std::endl;
-              return EXIT_ERROR;
-            }
-            // std::cout << "Check Dead Assignments\n";
-            // if (!static_check::LiveVariableAnalysis::checkDeadAssignments(
-            //         cfg)) {
-            //   std::cerr << "Warning: Method " << method->getName()
-            //             << " has dead assignments" << std::endl;
-            //   retCode = EXIT_WARNING;
-            // }
-          } else {
-            std::cout << "Method is null or has no body." << std::endl;
+  // environment (symbol table) building + type linking
+  auto typeLinker = std::make_shared<static_check::TypeLinker>(astManager, env);
+  std::shared_ptr<static_check::Package> rootPackage =
+      typeLinker->getRootPackage();
+  // rootPackage->printStructure();
+  std::cout << "Starting type linking\n";
+  utils::TimeReport::Scope typeLinkingPhase{"type linking"};
+  typeLinker->resolve(numJobs);
+  typeLinkingPhase.stop();
+  std::cout << "Populating java.lang\n";
+  utils::TimeReport::Scope javaLangPhase{"populate java.lang"};
+  typeLinker->populateJavaLang();
+  javaLangPhase.stop();
+  std::cout << "Passed type linking\n";
+
+  if (astManager->allDecls.size() != astManager->getASTs().size()) {
+    std::cerr << "Mismatch from number of ASTs to number of classes/interfaces"
+              << std::endl;
+    std::cerr << "Number of classes/interfaces: "
+              << astManager->allDecls.size() << ", ";
+    std::cerr << "Number of ASTs: " << astManager->getASTs().size()
+              << std::endl;
+    return EXIT_ERROR;
+  }
+
+  // astManager->getASTs()[2]->print(std::cout);
+
+  auto populateMethodPass =
+      parsetree::ast::PopulateMethodPass(astManager, typeLinker);
+  utils::TimeReport::Scope populateMethodsPhase{"populate methods"};
+  populateMethodPass.populate();
+  populateMethodsPhase.stop();
+
+  // hierarchy checking
+  auto hierarchyChecker =
+      std::make_shared<static_check::HierarchyCheck>(rootPackage);
+  std::cout << "Starting hierarchy check" << std::endl;
+  utils::TimeReport::Scope hierarchyPhase{"hierarchy check"};
+  if (!hierarchyChecker->check()) {
+    std::cout << "Did not pass hierarchy check\n";
+    return EXIT_ERROR;
+  }
+  astManager->hierarchy.build(astManager->getASTs());
+  hierarchyPhase.stop();
+  std::cout << "Passed hierarchy check\n";
+
+  // for (auto &ast : astManager->getASTs()) {
+  //   checkLinked(ast);
+  // }
+
+  std::cout << "Starting name disambiguation and type checking...\n";
+
+  astManager->getASTs()[0]->print(std::cout);
+
+  auto typeResolver =
+      std::make_shared<static_check::TypeResolver>(astManager, env);
+
+  auto exprResolver = std::make_shared<static_check::ExprResolver>(
+      astManager, hierarchyChecker, typeLinker, typeResolver);
+  utils::TimeReport::Scope exprPhase{"expr resolution"};
+  exprResolver->resolve();
+  exprPhase.stop();
+
+  utils::TimeReport::Scope validationPhase{"ast validation"};
+  auto astValidator =
+      std::make_shared<static_check::ASTValidator>(typeResolver);
+  astValidator->validate(astManager);
+
+  auto forwardChecker = std::make_shared<static_check::ForwardChecker>();
+  forwardChecker->check(astManager);
+  validationPhase.stop();
+
+  std::cout << "Name disambiguation and type checking passed\n";
+
+  auto cfgBuilder = std::make_shared<static_check::CFGBuilder>();
+  std::cout << "Start building CFGs....\n";
+  utils::TimeReport::Scope cfgPhase{"cfg reachability"};
+  for (auto ast : astManager->getASTs()) {
+    utils::TimeReport::Scope unit{"cfg reachability",
+                                  ast->getBody()->asDecl()->getName()};
+    for (auto decl : ast->getBody()->getDecls()) {
+      if (auto method =
+              std::dynamic_pointer_cast<parsetree::ast::MethodDecl>(decl)) {
+        // std::cout << "=== Start building CFG for method " <<
+        // method->getName()
+        //           << " ===" << std::endl;
+        std::shared_ptr<CFG> cfg = cfgBuilder->buildCFG(method);
+        // std::cout << "=== Done building CFG for method " <<
+        // method->getName()
+        //           << " ===" << std::endl;
+        if (cfg) {
+          // cfg->print(std::cout);
+          if (!static_check::ReachabilityAnalysis::checkUnreachableStatements(
+                  cfg)) {
+            std::cerr << "Method " << method->getName()
+                      << " has unreachable statements" << std::endl;
+            return EXIT_ERROR;
+          }
+          if (!static_check::ReachabilityAnalysis::checkFiniteLengthReturn(
+                  cfg, method)) {
+            std::cerr
+                << "Method " << method->getName()
+                << " finite-length execution paths do not all end in return"
+                << std::endl;
+            return EXIT_ERROR;
           }
+          // std::cout << "Check Dead Assignments\n";
+          // if (!static_check::LiveVariableAnalysis::checkDeadAssignments(
+          //         cfg)) {
+          //   std::cerr << "Warning: Method " << method->getName()
+          //             << " has dead assignments" << std::endl;
+          //   retCode = EXIT_WARNING;
+          // }
+        } else {
+          std::cout << "Method is null or has no body." << std::endl;
         }
       }
     }
-    std::cout << "Done building CFGs....\n";
+  }
+  cfgPhase.stop();
+  std::cout << "Done building CFGs....\n";
+  return EXIT_SUCCESS;
+}
+
+int main(int argc, char **argv) {
+  int retCode = EXIT_SUCCESS;
+  try {
+    if (argc == 1) {
+      std::cerr << "Usage: " << argv[0]
+                << " [-j N] [--time-report[=json]] [--emit-lib-cache=F]"
+                << " [--use-lib-cache=F] [--emit-checked-ast=F]"
+                << " [--use-checked-ast=F] input-files... " << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    auto astManager = std::make_shared<parsetree::ast::ASTManager>();
+
+    // Split options from input files
+    std::vector<std::string> inputFiles;
+    std::string emitLibCache;
+    std::string useLibCache;
+    std::string emitCheckedAst;
+    std::string useCheckedAst;
+    unsigned numJobs = 1;
+    // Reports per phase timings on stderr once main returns
+    std::optional<utils::TimeReport> timeReport;
+    for (int i = 1; i < argc; ++i) {
+      std::string arg(argv[i]);
+      if (arg.starts_with("--emit-lib-cache=")) {
+        emitLibCache = arg.substr(17);
+      } else if (arg.starts_with("--use-lib-cache=")) {
+        useLibCache = arg.substr(16);
+      } else if (arg.starts_with("--emit-checked-ast=")) {
+        emitCheckedAst = arg.substr(19);
+      } else if (arg.starts_with("--use-checked-ast=")) {
+        useCheckedAst = arg.substr(18);
+      } else if (arg == "--time-report" || arg == "--time-report=table") {
+        timeReport.emplace(utils::TimeReport::Format::Table);
+      } else if (arg == "--time-report=json") {
+        timeReport.emplace(utils::TimeReport::Format::Json);
+      } else if (arg.starts_with("-j")) {
+        std::string jobs = arg.size() > 2 ? arg.substr(2)
+                           : i + 1 < argc ? std::string(argv[++i])
+                                          : "";
+        try {
+          numJobs = std::stoul(jobs);
+        } catch (const std::exception &) {
+          std::cerr << "Invalid job count for -j: " << jobs << std::endl;
+          return EXIT_FAILURE;
+        }
+        // -j 0 means one job per core
+        if (numJobs == 0)
+          numJobs = std::max(1u, std::thread::hardware_concurrency());
+      } else if (!arg.starts_with("--")) {
+        inputFiles.push_back(arg);
+      }
+    }
+
+    if (!useCheckedAst.empty()) {
+      // Checked in an earlier run, straight to codegen
+      utils::TimeReport::Scope loadPhase{"load checked ast"};
+      astManager = parsetree::ast::ASTSerializer::load(useCheckedAst);
+      astManager->hierarchy.build(astManager->getASTs());
+      loadPhase.stop();
+      std::cout << "Loaded checked AST " << useCheckedAst << "\n";
+    } else {
+      int checkResult = checkProgram(inputFiles, numJobs, useLibCache,
+                                     emitLibCache, astManager);
+      if (checkResult != EXIT_SUCCESS)
+        return checkResult;
+      if (!emitCheckedAst.empty()) {
+        utils::TimeReport::Scope savePhase{"save checked ast"};
+        parsetree::ast::ASTSerializer::save(*astManager, emitCheckedAst);
+        savePhase.stop();
+        std::cout << "Wrote checked AST " << emitCheckedAst << "\n";
+      }
+    }
 
     // astManager->getASTs()[0]->print(std::cout);
 
@@ -285,6 +481,7 @@ int main(int argc, char **argv) {
         astManager, codeGenLabels, innerExprConverter);
 
     // for object oriented
+    utils::TimeReport::Scope dvPhase{"dispatch vectors"};
     auto dvBuilder = codegen::DispatchVectorBuilder();
     dvBuilder.visit(astManager);
     codegen::DispatchVectorBuilder::assignColours();
@@ -294,33 +491,39 @@ int main(int argc, char **argv) {
     }
 
     codegen::DispatchVectorBuilder::verifyColoured();
+    dvPhase.stop();
 
     // IR building
     auto tirBuilder =
         std::make_shared<tir::TIRBuilder>(astManager, exprConverter);
+    utils::TimeReport::Scope tirPhase{"tir building"};
     tirBuilder->run();
+    tirPhase.stop();
     // tirBuilder->print(std::cout);
 
     // canonicalize IR
+    utils::TimeReport::Scope canonicalizePhase{"canonicalization"};
     auto tirCanonicalizer =
         std::make_shared<codegen::TIRCanonicalizer>(codeGenLabels);
     for (auto &compUnit : tirBuilder->getCompUnits()) {
+      utils::TimeReport::Scope unit{"canonicalization", compUnit->getName()};
       tirCanonicalizer->canonicalizeCompUnit(compUnit);
     }
+    canonicalizePhase.stop();
     std::cout << "Done canonicalizing IR\n";
     tirBuilder->print(std::cout);
 
     // Get entrypoint method as a string
     std::string entry_class;
-    for (int i = 1; i < argc; ++i) {
-      std::string arg = argv[i];
-      if (!arg.starts_with("--")) {
-        size_t slash = arg.find_last_of("/\\");
-        size_t dot = arg.find_last_of('.');
-        std::string filename = arg.substr(slash + 1, dot - slash - 1);
-        entry_class = filename;
-        break;
-      }
+    if (!inputFiles.empty()) {
+      const std::string &arg = inputFiles.front();
+      size_t slash = arg.find_last_of("/\\");
+      size_t dot = arg.find_last_of('.');
+      entry_class = arg.substr(slash + 1, dot - slash - 1);
+    } else if (!astManager->getASTs().empty()) {
+      // --use-checked-ast without files, the ASTs keep the input file order
+      auto first = astManager->getASTs().front()->getBody()->asDecl();
+      entry_class = first ? first->getName() : "";
     }
 
     if (entry_class.empty()) {
@@ -402,7 +605,9 @@ int main(int argc, char **argv) {
     }
     auto assemblyGenerator = std::make_shared<codegen::AssemblyGenerator>(
         codeGenLabels, registerAllocator, entry_method);
+    utils::TimeReport::Scope assemblyPhase{"assembly generation"};
     assemblyGenerator->generateAssembly(tirBuilder->getCompUnits());
+    assemblyPhase.stop();
 
     return retCode;
   } catch (const std::runtime_error &err) {
@@ -4,6 +4,8 @@
 #include <unistd.h>
 
 #include "parseTree/parseTree.hpp"
+#include "parseTree/sourceFile.hpp"
+#include "parseTree/sourceNode.hpp"
 #include "parser/myBisonParser.hpp"
 
 extern std::string parser_resolve_token(int yysymbol);
@@ -40,8 +42,16 @@ int main() {
       }
     }
 
+    // Line table for the error location
+    source::SourceManager sm;
+    const int fileID = sm.addFile("<stdin>");
+    std::vector<uint32_t> lineStarts;
+    source::scanSource(input, lineStarts);
+    sm.setLineStarts(fileID, std::move(lineStarts));
+
     // Initialize the parser with the input
     myBisonParser parser{input};
+    parser.setFileID(fileID);
 
     // Parse
     const char *env_var =
@@ -51,7 +61,11 @@ int main() {
       std::cout << "====== DEBUG MODE ======\n";
     }
     std::shared_ptr<parsetree::Node> root = nullptr;
-    parser.parse(root);
+    if (parser.parse(root) || !root) {
+      std::cerr << "Parsing error! : " << parser.getSyntaxError() << "\n";
+      sm.printRange(std::cerr, parser.getSyntaxErrorLoc());
+      continue;
+    }
 
     std::cout << "====== Resulting Tree ======\n";
     root->print(std::cout);
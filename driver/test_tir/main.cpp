@@ -11,6 +11,7 @@
 #include "ast/ast.hpp"
 #include "parseTree/parseTree.hpp"
 #include "parseTree/parseTreeVisitor.hpp"
+#include "parseTree/sourceFile.hpp"
 #include "parseTree/sourceNode.hpp"
 #include "parser/myBisonParser.hpp"
 #include "staticCheck/astValidator.hpp"
@@ -62,21 +63,6 @@
 //   }
 // }
 
-// hack
-bool isLiteralTypeValid(const std::shared_ptr<parsetree::Node> &node) {
-  if (!node)
-    return true;
-
-  if (node->get_node_type() == parsetree::Node::Type::Literal) {
-    auto literalNode = std::dynamic_pointer_cast<parsetree::Literal>(node);
-    return literalNode && literalNode->isValid();
-  }
-
-  return std::all_of(
-      node->children().begin(), node->children().end(),
-      [](const auto &child) { return isLiteralTypeValid(child); });
-}
-
 int main(int argc, char **argv) {
   int retCode = EXIT_SUCCESS;
   try {
@@ -103,7 +89,7 @@ int main(int argc, char **argv) {
       }
 
       // Track file
-      sm.addFile(fileName);
+      const int fileID = sm.addFile(fileName);
 
       // Read file content
       std::ifstream inputFile(filePath, std::ios::binary);
@@ -115,35 +101,31 @@ int main(int argc, char **argv) {
       const std::string fileContent((std::istreambuf_iterator<char>(inputFile)),
                                     std::istreambuf_iterator<char>());
 
-      // Check for non-ASCII characters
-      if (std::any_of(fileContent.begin(), fileContent.end(), [](char c) {
-            return static_cast<unsigned char>(c) > 127;
-          })) {
+      // Check for non-ASCII characters, indexing lines on the same pass
+      std::vector<uint32_t> lineStarts;
+      if (!source::scanSource(fileContent, lineStarts)) {
         std::cerr << "Parse error: non-ASCII character in input" << std::endl;
         return EXIT_ERROR;
       }
+      sm.setLineStarts(fileID, std::move(lineStarts));
 
       // Parse the input
       std::shared_ptr<parsetree::Node> parse_tree;
       myBisonParser parser{fileContent};
-      parser.setFileID(file_number);
+      parser.setFileID(fileID);
       int result = parser.parse(parse_tree);
 
       // Validate parse result
-      if (!parse_tree || result) {
-        std::cerr << "Parse error: parse failed" << std::endl;
-        return EXIT_ERROR;
-      }
-      if (parse_tree->is_corrupted()) {
+      if (parser.hasInvalidConstruct()) {
         std::cerr << "Parse error: parse tree is invalid" << std::endl;
-        // comment out if not debugging
-        // parse_tree->print(std::cerr);
         return EXIT_ERROR;
       }
-
-      // Validate literal types
-      if (!isLiteralTypeValid(parse_tree)) {
-        std::cerr << "Parse error: invalid literal type" << std::endl;
+      if (!parse_tree || result) {
+        if (!parser.getSyntaxError().empty()) {
+          std::cerr << "Parsing error! : " << parser.getSyntaxError() << "\n";
+          sm.printRange(std::cerr, parser.getSyntaxErrorLoc());
+        }
+        std::cerr << "Parse error: parse failed" << std::endl;
         return EXIT_ERROR;
       }
 
@@ -154,8 +136,6 @@ int main(int argc, char **argv) {
       std::shared_ptr<parsetree::ast::ProgramDecl> ast;
       parsetree::ParseTreeVisitor visitor{env};
       try {
-        if (parse_tree->is_corrupted())
-          throw std::runtime_error("Parse tree is invalid");
         ast = visitor.visitProgramDecl(parse_tree);
       } catch (const std::exception &ex) {
         std::cerr << "Runtime error: " << ex.what() << std::endl;
@@ -208,6 +188,7 @@ int main(int argc, char **argv) {
       std::cout << "Did not pass hierarchy check\n";
       return EXIT_ERROR;
     }
+    astManager->hierarchy.build(astManager->getASTs());
     std::cout << "Passed hierarchy check\n";
 
     // for (auto &ast : astManager->getASTs()) {
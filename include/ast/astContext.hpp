@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <memory_resource>
+
+namespace parsetree::ast {
+
+// Owns the memory of the AST nodes built for a file. Nodes are bump
+// allocated, so nodes built one after another (e.g. the RPN of an
+// expression) are next to each other in memory, and the whole arena is
+// released in one go instead of one free per node.
+//
+// Nodes are still handed out as shared_ptrs, the passes keep and swap
+// them freely. Each control block holds a reference to the arena through
+// its allocator, so the arena goes away with the last node from it, after
+// codegen, whichever pass ends up holding that node.
+//
+// Not thread safe, use one context per thread (one per file in the front
+// end).
+class ASTContext {
+  struct Arena {
+    std::pmr::monotonic_buffer_resource resource;
+    std::atomic<size_t> refs = 1;
+  };
+
+  static Arena *retain(Arena *arena) {
+    arena->refs.fetch_add(1, std::memory_order_relaxed);
+    return arena;
+  }
+  static void release(Arena *arena) {
+    if (arena->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+      delete arena;
+  }
+
+public:
+  // Just a pointer, so it adds 8 bytes to each control block
+  template <typename T> class Allocator {
+  public:
+    using value_type = T;
+
+    explicit Allocator(Arena *arena) : arena{retain(arena)} {}
+    Allocator(const Allocator &other) : arena{retain(other.arena)} {}
+    template <typename U>
+    Allocator(const Allocator<U> &other) : arena{retain(other.arena)} {}
+    Allocator &operator=(const Allocator &other) {
+      Arena *old = arena;
+      arena = retain(other.arena);
+      release(old);
+      return *this;
+    }
+    ~Allocator() { release(arena); }
+
+    T *allocate(std::size_t n) {
+      return static_cast<T *>(
+          arena->resource.allocate(n * sizeof(T), alignof(T)));
+    }
+    // released all at once with the arena
+    void deallocate(T *, std::size_t) noexcept {}
+
+    template <typename U> bool operator==(const Allocator<U> &other) const {
+      return arena == other.arena;
+    }
+
+  private:
+    template <typename U> friend class Allocator;
+    Arena *arena;
+  };
+
+  ASTContext() : arena{new Arena} {}
+  ~ASTContext() { release(arena); }
+
+  ASTContext(const ASTContext &) = delete;
+  ASTContext &operator=(const ASTContext &) = delete;
+
+  template <typename T, typename... Args>
+  std::shared_ptr<T> make(Args &&...args) {
+    return std::allocate_shared<T>(Allocator<T>{arena},
+                                   std::forward<Args>(args)...);
+  }
+
+private:
+  Arena *arena;
+};
+
+} // namespace parsetree::ast
@@ -12,7 +12,7 @@ class Literal;
 class ExprValue : public ExprNode {
 public:
   explicit ExprValue(std::shared_ptr<Type> type = nullptr)
-      : ExprNode{}, decl_{nullptr}, type_{type} {}
+      : ExprNode{Kind::Value}, decl_{nullptr}, type_{type} {}
 
   std::shared_ptr<Decl> getResolvedDecl() const { return decl_; }
   std::shared_ptr<Type> getType() const { return type_; }
@@ -69,14 +69,16 @@ public:
 private:
   std::shared_ptr<Decl> decl_;
   std::shared_ptr<Type> type_;
+
+  friend class ASTSerializer;
 };
 
 class SimpleName : public ExprValue {
 public:
-  SimpleName(std::string name)
-      : ExprValue{}, name{name}, shouldBeStatic{false} {}
+  SimpleName(Symbol name) : ExprValue{}, name{name}, shouldBeStatic{false} {}
 
-  std::string getName() const { return name; }
+  const std::string &getName() const { return name.str(); }
+  Symbol getSymbol() const { return name; }
 
   // std::shared_ptr<Decl> getResolvedDecl() {
   //   return resolvedDecl;
@@ -96,7 +98,7 @@ public:
   void setShouldBeStatic() { shouldBeStatic = true; }
 
 private:
-  std::string name;
+  Symbol name;
   // std::shared_ptr<Decl> resolvedDecl;
 
   bool shouldBeStatic;
@@ -104,7 +106,7 @@ private:
 
 class QualifiedName : public ExprNode {
 public:
-  QualifiedName(){};
+  QualifiedName() : ExprNode{Kind::QualifiedName} {};
 
   int size() { return simpleNames.size(); }
 
@@ -114,7 +116,7 @@ public:
   std::shared_ptr<SimpleName> getLast() { return simpleNames[size() - 1]; }
   std::string getLastName() { return simpleNames[size() - 1]->getName(); }
 
-  void add(std::string name) {
+  void add(Symbol name) {
     simpleNames.push_back(std::make_shared<SimpleName>(name));
   }
   void add(std::shared_ptr<SimpleName> simpleName) {
@@ -137,12 +139,10 @@ public:
     return os;
   }
 
-  std::vector<std::shared_ptr<AstNode>> getChildren() const override {
-    std::vector<std::shared_ptr<AstNode>> children;
+  void forEachChild(ChildVisitor visit) const override {
     for (const auto &simpleName : simpleNames) {
-      children.push_back(std::dynamic_pointer_cast<AstNode>(simpleName));
+      visit(simpleName);
     }
-    return children;
   }
 
 private:
@@ -151,7 +151,7 @@ private:
 
 class MemberName : public ExprValue {
 public:
-  MemberName(std::string name, const source::SourceRange loc)
+  MemberName(Symbol name, const source::SourceRange loc)
       : ExprValue{}, name{name}, loc{loc} {}
 
   std::ostream &print(std::ostream &os, int indent = 0) const override {
@@ -165,14 +165,15 @@ public:
   void setinitializedInExpr() { initializedInExpr = true; }
 
   // Getters
-  std::string getName() const { return name; }
+  const std::string &getName() const { return name.str(); }
+  Symbol getSymbol() const { return name; }
   const source::SourceRange getLoc() const { return loc; }
   bool isAccessedByThis() const { return accessedByThis; }
   bool isNotAsBase() const { return notAsBase; }
   bool isinitializedInExpr() const { return initializedInExpr; }
 
 private:
-  std::string name;
+  Symbol name;
   const source::SourceRange loc;
   bool accessedByThis = false;
   bool notAsBase = false;
@@ -181,7 +182,7 @@ private:
 
 class MethodName : public MemberName {
 public:
-  MethodName(std::string name, const source::SourceRange loc)
+  MethodName(Symbol name, const source::SourceRange loc)
       : MemberName{name, loc} {}
 
   std::ostream &print(std::ostream &os, int indent = 0) const override {
@@ -251,6 +252,8 @@ public:
 
 class Separator : public ExprNode {
 public:
+  Separator() : ExprNode{Kind::Separator} {}
+
   std::ostream &print(std::ostream &os, int indent = 0) const {
     // Don't know what this is for, not putting an indent
     return os << " (|) ";
@@ -287,11 +290,13 @@ public:
   }
 
 protected:
-  ExprOp(int num_args) : num_args{num_args} {}
+  ExprOp(Kind kind, int num_args) : ExprNode{kind}, num_args{num_args} {}
 
 private:
   int num_args;
   std::shared_ptr<Type> resultType;
+
+  friend class ASTSerializer;
 };
 
 // For AST
@@ -300,7 +305,7 @@ private:
 class UnOp : public ExprOp {
 public:
   enum class OpType { Not, Plus, Minus };
-  UnOp(OpType op) : ExprOp{1}, op{op} {}
+  UnOp(OpType op) : ExprOp{Kind::UnOp, 1}, op{op} {}
 
   std::ostream &print(std::ostream &os, int indent = 0) const override {
     printIndent(os, indent);
@@ -339,7 +344,7 @@ public:
     And,
     Or
   };
-  BinOp(OpType op) : ExprOp{2}, op{op} {}
+  BinOp(OpType op) : ExprOp{Kind::BinOp, 2}, op{op} {}
 
   std::ostream &print(std::ostream &os, int indent = 0) const override {
     printIndent(os, indent);
@@ -373,7 +378,7 @@ private:
 class Assignment : public ExprOp {
   std::shared_ptr<VarDecl> assignedVariable; // only for assignment
 public:
-  Assignment() : ExprOp(2){};
+  Assignment() : ExprOp(Kind::Assignment, 2){};
 
   std::ostream &print(std::ostream &os, int indent = 0) const override {
     printIndent(os, indent);
@@ -396,8 +401,9 @@ class MethodInvocation : public ExprOp {
 
 public:
   MethodInvocation(int num_args,
-                   std::vector<std::shared_ptr<ast::ExprNode>> &qid)
-      : ExprOp(num_args), qualifiedIdentifier{qid} {}
+                   std::vector<std::shared_ptr<ast::ExprNode>> qid)
+      : ExprOp(Kind::MethodInvocation, num_args),
+        qualifiedIdentifier{std::move(qid)} {}
   std::vector<std::shared_ptr<ast::ExprNode>> &getQualifiedIdentifier() {
     return qualifiedIdentifier;
   }
@@ -425,7 +431,7 @@ public:
 
 class ClassCreation : public ExprOp {
 public:
-  ClassCreation(int num_args) : ExprOp(num_args) {}
+  ClassCreation(int num_args) : ExprOp(Kind::ClassCreation, num_args) {}
 
   std::ostream &print(std::ostream &os, int indent = 0) const override {
     printIndent(os, indent);
@@ -437,7 +443,7 @@ public:
 class FieldAccess : public ExprOp {
 public:
   // Question: Why 1?
-  FieldAccess() : ExprOp(1) {}
+  FieldAccess() : ExprOp(Kind::FieldAccess, 1) {}
 
   std::ostream &print(std::ostream &os, int indent = 0) const override {
     printIndent(os, indent);
@@ -448,7 +454,7 @@ public:
 
 class ArrayCreation : public ExprOp {
 public:
-  ArrayCreation() : ExprOp(2) {}
+  ArrayCreation() : ExprOp(Kind::ArrayCreation, 2) {}
 
   std::ostream &print(std::ostream &os, int indent = 0) const override {
     printIndent(os, indent);
@@ -459,7 +465,7 @@ public:
 
 class ArrayAccess : public ExprOp {
 public:
-  ArrayAccess() : ExprOp(2) {}
+  ArrayAccess() : ExprOp(Kind::ArrayAccess, 2) {}
 
   std::ostream &print(std::ostream &os, int indent = 0) const override {
     printIndent(os, indent);
@@ -472,7 +478,7 @@ class Cast : public ExprOp {
   std::shared_ptr<parsetree::ast::Literal> rhsLiteral = nullptr;
 
 public:
-  Cast() : ExprOp(2) {}
+  Cast() : ExprOp(Kind::Cast, 2) {}
 
   bool hasRhsLiteral() const { return rhsLiteral != nullptr; }
   void setRhsLiteral(std::shared_ptr<parsetree::ast::Literal> literal) {
@@ -563,16 +569,11 @@ public:
         literalType = Literal::Type::Character;
         val = parseChar(str);
       } else {
-        // Convert the string to an integer
-        try {
-          literalType = Literal::Type::Integer;
-          if (node->isNegativeVal())
-            val = std::stoi("-" + std::string(str));
-          else
-            val = std::stoi(std::string(str));
-        } catch (std::invalid_argument &e) {
+        // Already parsed (and range checked) by the lexer
+        literalType = Literal::Type::Integer;
+        if (!node->isValid())
           throw std::runtime_error("Invalid integer literal");
-        }
+        val = node->getIntValue();
       }
       value = val;
     }
@@ -605,6 +606,11 @@ public:
     }
   }
 
+  // Already parsed value, for reading back a checked AST
+  Literal(Type literalType, std::variant<int64_t, std::string> value,
+          std::shared_ptr<BasicType> type)
+      : ExprValue{type}, literalType{literalType}, value{std::move(value)} {}
+
   std::ostream &print(std::ostream &os, int indent = 0) const override {
     // os << "(Literal " << magic_enum::enum_name(type) << ", " << value <<
     // ")"; return os;
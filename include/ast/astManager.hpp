@@ -1,6 +1,8 @@
 #pragma once
 
 #include "ast/astNode.hpp"
+#include "ast/hierarchyIndex.hpp"
+#include "ast/typeTable.hpp"
 
 namespace parsetree::ast {
 
@@ -9,7 +11,9 @@ private:
   std::vector<std::shared_ptr<parsetree::ast::ProgramDecl>> asts;
 
 public:
-  void addAST(std::shared_ptr<ProgramDecl> ast) { asts.push_back(ast); }
+  void addAST(std::shared_ptr<ProgramDecl> ast) {
+    asts.push_back(std::move(ast));
+  }
 
   const std::vector<std::shared_ptr<parsetree::ast::ProgramDecl>> &
   getASTs() const {
@@ -34,6 +38,12 @@ public:
   } java_lang;
 
   std::vector<std::shared_ptr<parsetree::ast::Decl>> allDecls;
+
+  // Canonical types for the passes after the front end
+  TypeTable types;
+
+  // Subtype queries, built once the hierarchy check has passed
+  HierarchyIndex hierarchy;
 };
 
 } // namespace parsetree::ast
@@ -1,11 +1,14 @@
 #pragma once
 
+#include "ast/scopeID.hpp"
 #include "parseTree/parseTree.hpp"
 #include "parseTree/sourceNode.hpp"
 #include <iostream>
 #include <list>
 #include <memory>
 #include <string>
+#include <type_traits>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -17,6 +20,7 @@ namespace parsetree::ast {
 
 // Base class for all AST nodes //////////////////////////////////////////////
 
+class AstNode;
 class ReferenceType;
 class Expr;
 class ExprOp;
@@ -28,8 +32,34 @@ class VarDecl;
 class StatementExpr;
 class Block;
 class UnresolvedType;
-class ScopeID;
 class CodeBody;
+class ASTSerializer;
+
+// Non-owning reference to whatever callable is passed to forEachChild, so
+// walking children doesn't allocate (unlike a std::function or a vector)
+class ChildVisitor {
+public:
+  template <typename F>
+    requires(!std::is_same_v<std::remove_cvref_t<F>, ChildVisitor>)
+  ChildVisitor(F &&fn)
+      : fn{const_cast<void *>(static_cast<const void *>(std::addressof(fn)))},
+        call{[](void *fn, const std::shared_ptr<AstNode> &child) {
+          (*static_cast<std::remove_reference_t<F> *>(fn))(child);
+        }} {}
+
+  // A template so the upcast is only checked once T is complete
+  template <typename T> void operator()(const std::shared_ptr<T> &child) const {
+    if constexpr (std::is_same_v<T, AstNode>) {
+      call(fn, child);
+    } else {
+      call(fn, std::shared_ptr<AstNode>(child));
+    }
+  }
+
+private:
+  void *fn;
+  void (*call)(void *, const std::shared_ptr<AstNode> &);
+};
 
 class AstNode {
 protected:
@@ -37,8 +67,18 @@ protected:
 
 public:
   virtual ~AstNode() = default;
-  virtual std::vector<std::shared_ptr<AstNode>> getChildren() const {
-    return std::vector<std::shared_ptr<AstNode>>();
+
+  // Calls visit on each child in order, null children included. Recursive
+  // passes should use this, it runs at every node.
+  virtual void forEachChild(ChildVisitor /*visit*/) const {}
+
+  // Same children collected into a vector, for callers that need one
+  std::vector<std::shared_ptr<AstNode>> getChildren() const {
+    std::vector<std::shared_ptr<AstNode>> children;
+    forEachChild([&](const std::shared_ptr<AstNode> &child) {
+      children.push_back(child);
+    });
+    return children;
   }
 
   virtual std::ostream &print(std::ostream &os, int indent = 0) const = 0;
@@ -46,16 +86,21 @@ public:
 
 class Decl : virtual public AstNode {
 protected:
-  std::string name;
+  Symbol name; // interned by the lexer, lookups compare these
   std::weak_ptr<CodeBody> parent;
   source::SourceRange loc;
   std::string fullName = "";
 
+  friend class ASTSerializer;
+
 public:
-  explicit Decl(std::string name,
+  explicit Decl(Symbol name,
                 const source::SourceRange loc = source::SourceRange())
       : name{name}, loc{loc} {}
-  [[nodiscard]] std::string getName() const noexcept { return name; }
+  [[nodiscard]] const std::string &getName() const noexcept {
+    return name.str();
+  }
+  [[nodiscard]] Symbol getSymbol() const noexcept { return name; }
   [[nodiscard]] std::shared_ptr<CodeBody> getParent() const noexcept {
     return parent.lock();
   }
@@ -69,7 +114,7 @@ public:
 
   std::string getFullName() const {
     if (fullName.empty()) {
-      return name;
+      return name.str();
     }
     return fullName;
   }
@@ -88,7 +133,8 @@ public:
     std::cout << "(Decl: " << astNode->getName() << ")"
               << "\n";
   }
-  std::string getName() const { return astNode->getName(); }
+  const std::string &getName() const { return astNode->getName(); }
+  parsetree::Symbol getSymbol() const { return astNode->getSymbol(); }
   std::shared_ptr<parsetree::ast::Decl> getAstNode() const { return astNode; }
 
   bool operator==(const Decl &other) const { return astNode == other.astNode; }
@@ -135,28 +181,63 @@ public:
 
 class Type : public AstNode {
 public:
+  // Set once at construction, like ExprNode::Kind, so type checks can
+  // compare it and static_cast instead of trying dynamic casts (see
+  // typeCast)
+  enum class TypeKind : uint8_t { Basic, Array, Reference, Method };
+
+  explicit Type(TypeKind typeKind) : typeKind{typeKind} {}
   ~Type() override = default;
+
+  TypeKind getTypeKind() const noexcept { return typeKind; }
+
   [[nodiscard]] virtual std::string toString() const = 0;
   [[nodiscard]] virtual bool isResolved() const = 0;
-  [[nodiscard]] virtual bool isString() const { return false; };
-  [[nodiscard]] virtual bool isPrimitive() const { return false; };
-  [[nodiscard]] virtual bool isNull() const { return false; };
-  [[nodiscard]] virtual bool isNumeric() const { return false; }
-  [[nodiscard]] virtual bool isCharacter() const { return false; }
-  [[nodiscard]] virtual bool isBoolean() const { return false; }
-  [[nodiscard]] virtual bool isArray() const { return false; }
+
+  // Precomputed flags, the type checker asks these for every operand
+  [[nodiscard]] bool isString() const { return flags & StringFlag; };
+  [[nodiscard]] bool isPrimitive() const { return flags & PrimitiveFlag; };
+  [[nodiscard]] bool isNull() const { return flags & NullFlag; };
+  [[nodiscard]] bool isNumeric() const { return flags & NumericFlag; }
+  [[nodiscard]] bool isCharacter() const { return flags & CharacterFlag; }
+  [[nodiscard]] bool isBoolean() const { return flags & BooleanFlag; }
+  [[nodiscard]] bool isArray() const { return flags & ArrayFlag; }
 
   [[nodiscard]] virtual std::shared_ptr<Decl> getAsDecl() const {
     return nullptr;
   }
 
-  virtual bool operator==(const Type &other) const = 0;
+  // Canonical types (see TypeTable) are shared, so most checks end at the
+  // pointer compare
+  bool operator==(const Type &other) const {
+    if (this == &other)
+      return true;
+    return typeKind == other.typeKind && equals(other);
+  }
 
   // std::ostream &print(std::ostream &os, int indent = 0) const override {
   //   if (!toString().empty())
   //     printIndent(os, indent);
   //   return os << toString();
   // }
+
+protected:
+  enum Flag : uint8_t {
+    StringFlag = 1 << 0,
+    PrimitiveFlag = 1 << 1,
+    NullFlag = 1 << 2,
+    NumericFlag = 1 << 3,
+    CharacterFlag = 1 << 4,
+    BooleanFlag = 1 << 5,
+    ArrayFlag = 1 << 6
+  };
+  uint8_t flags = 0;
+
+  // Structural equality, other is never this and has the same TypeKind
+  virtual bool equals(const Type &other) const = 0;
+
+private:
+  const TypeKind typeKind;
 };
 
 class Stmt : public AstNode {
@@ -172,36 +253,59 @@ std::ostream &operator<<(std::ostream &os, const AstNode &astNode);
 
 class ExprNode : public AstNode {
 public:
+  // Set once at construction so the evaluators can switch on it and
+  // static_cast instead of trying dynamic_pointer_casts one after another
+  enum class Kind : uint8_t {
+    Other,
+    Value, // any ExprValue
+    QualifiedName,
+    Separator,
+    UnOp,
+    BinOp,
+    Assignment,
+    MethodInvocation,
+    ClassCreation,
+    FieldAccess,
+    ArrayCreation,
+    ArrayAccess,
+    Cast
+  };
+
+  explicit ExprNode(Kind kind = Kind::Other) : kind{kind} {}
   virtual ~ExprNode() = default;
+
+  Kind getKind() const noexcept { return kind; }
   // virtual std::ostream &print(std::ostream &os, int indent = 0) const = 0;
   std::ostream &print(std::ostream &os, int indent = 0) const override {
     printIndent(os, indent);
     return os << "(ExprNode)";
   }
+
+private:
+  const Kind kind;
 };
 
 class Expr : public AstNode {
   // Reverse Polish Notation
   // TODO: We use vector for now
   std::vector<std::shared_ptr<ExprNode>> exprNodes;
-  std::shared_ptr<ScopeID> scope;
+  ScopeID scope;
 
 public:
-  Expr(std::vector<std::shared_ptr<ExprNode>> exprNodes,
-       std::shared_ptr<ScopeID> scope)
-      : exprNodes{exprNodes}, scope{scope} {}
+  Expr(std::vector<std::shared_ptr<ExprNode>> exprNodes, ScopeID scope)
+      : exprNodes{std::move(exprNodes)}, scope{std::move(scope)} {}
 
-  // Getter
-  // right now we return a copy, inefficient i know...
+  // The RPN itself, not a copy. The nodes are usually out of an ASTContext,
+  // so walking it in order touches mostly contiguous memory.
   std::vector<std::shared_ptr<ExprNode>> &getExprNodes() { return exprNodes; }
 
-  std::shared_ptr<ScopeID> getScope() { return scope; }
+  const ScopeID &getScope() const { return scope; }
 
   void setExprNodes(std::vector<std::shared_ptr<ExprNode>> exprNodes) {
-    this->exprNodes = exprNodes;
+    this->exprNodes = std::move(exprNodes);
   }
 
-  void setScope(std::shared_ptr<ScopeID> scope) { this->scope = scope; }
+  void setScope(ScopeID scope) { this->scope = std::move(scope); }
 
   const std::shared_ptr<ExprNode> getLastExprNode() const {
     if (exprNodes.empty()) {
@@ -220,12 +324,10 @@ public:
     return os << ")\n";
   }
 
-  std::vector<std::shared_ptr<AstNode>> getChildren() const override {
-    std::vector<std::shared_ptr<AstNode>> children;
+  void forEachChild(ChildVisitor visit) const override {
     for (const auto &node : exprNodes) {
-      children.push_back(std::dynamic_pointer_cast<AstNode>(node));
+      visit(node);
     }
-    return children;
   }
 };
 
@@ -233,15 +335,23 @@ class ReferenceType : public Type {
   std::shared_ptr<Decl> decl;
   static_check::Decl resolvedDecl = static_check::Decl{nullptr};
 
+  friend class ASTSerializer;
+
+  // Sets resolvedDecl and the flags that depend on it
+  void assignResolvedDecl(static_check::Decl resolvedDecl);
+
 protected:
   // Only used by unresolved types.
-  ReferenceType() : Type(), decl{nullptr} {}
+  ReferenceType() : Type(TypeKind::Reference), decl{nullptr} {}
+
+  bool equals(const Type &other) const override;
 
 public:
-  ReferenceType(std::shared_ptr<Decl> decl) : decl{decl} {}
-  virtual std::string toString() const override { return "ReferenceType"; }
+  static constexpr TypeKind KIND = TypeKind::Reference;
 
-  bool isString() const override;
+  ReferenceType(std::shared_ptr<Decl> decl)
+      : Type(TypeKind::Reference), decl{decl} {}
+  virtual std::string toString() const override { return "ReferenceType"; }
 
   bool isResolved() const override {
     return resolvedDecl.getAstNode() != nullptr;
@@ -257,16 +367,14 @@ public:
   static_check::Decl getResolvedDecl() { return resolvedDecl; }
 
   std::ostream &print(std::ostream &os, int indent = 0) const override;
-
-  bool operator==(const Type &other) const override;
 };
 
 class UnresolvedType : public ReferenceType {
-  std::vector<std::string> identifiers;
+  std::vector<Symbol> identifiers;
   mutable std::string originalName = "";
 
 public:
-  const std::vector<std::string> &getIdentifiers() const {
+  const std::vector<Symbol> &getIdentifiers() const {
     return identifiers;
   };
 
@@ -277,16 +385,14 @@ public:
       return originalName;
     }
     for (auto &id : identifiers) {
-      originalName += id;
+      originalName += id.str();
       originalName += ".";
     }
     originalName.pop_back();
     return originalName;
   }
 
-  void addIdentifier(std::string identifier) {
-    identifiers.emplace_back(identifier);
-  }
+  void addIdentifier(Symbol identifier) { identifiers.push_back(identifier); }
 
   std::ostream &print(std::ostream &os, int indent = 0) const override {
     printIndent(os, indent + 1);
@@ -301,7 +407,7 @@ class PackageDecl : public Decl {
   std::shared_ptr<ReferenceType> qualifiedIdentifier;
 
 public:
-  PackageDecl(std::string name,
+  PackageDecl(Symbol name,
               std::shared_ptr<ReferenceType> qualifiedIdentifier,
               const source::SourceRange loc)
       : Decl{name, loc}, qualifiedIdentifier{qualifiedIdentifier} {}
@@ -370,14 +476,12 @@ public:
 
   std::ostream &print(std::ostream &os, int indent = 0) const;
 
-  std::vector<std::shared_ptr<AstNode>> getChildren() const override {
-    std::vector<std::shared_ptr<AstNode>> children;
-    children.push_back(std::dynamic_pointer_cast<AstNode>(package));
+  void forEachChild(ChildVisitor visit) const override {
+    visit(package);
     for (const auto &node : imports) {
-      children.push_back(std::dynamic_pointer_cast<AstNode>(node));
+      visit(node);
     }
-    children.push_back(std::dynamic_pointer_cast<AstNode>(body));
-    return children;
+    visit(body);
   }
 };
 
@@ -452,15 +556,16 @@ public:
 class VarDecl : public Decl {
   std::shared_ptr<Type> type;
   std::shared_ptr<Expr> initializer;
-  std::shared_ptr<ScopeID> scope;
+  ScopeID scope;
   bool inParam = false;
   std::shared_ptr<Type> realType = nullptr;
 
 public:
-  VarDecl(std::shared_ptr<Type> type, std::string name,
-          std::shared_ptr<Expr> initializer, std::shared_ptr<ScopeID> scope,
+  VarDecl(std::shared_ptr<Type> type, Symbol name,
+          std::shared_ptr<Expr> initializer, ScopeID scope,
           const source::SourceRange &loc)
-      : Decl{name, loc}, type{type}, initializer{initializer}, scope{scope} {}
+      : Decl{name, loc}, type{type}, initializer{initializer},
+        scope{std::move(scope)} {}
 
   bool hasInit() const { return initializer != nullptr; }
   bool isInParam() const { return inParam; }
@@ -474,14 +579,12 @@ public:
   // Getters
   std::shared_ptr<Type> getType() const { return type; }
   std::shared_ptr<Expr> getInitializer() const { return initializer; }
-  std::shared_ptr<ScopeID> getScope() const { return scope; }
+  const ScopeID &getScope() const { return scope; }
   std::shared_ptr<Type> getRealType() const { return realType; }
 
-  std::vector<std::shared_ptr<AstNode>> getChildren() const override {
-    std::vector<std::shared_ptr<AstNode>> children;
-    children.push_back(std::dynamic_pointer_cast<AstNode>(type));
-    children.push_back(std::dynamic_pointer_cast<AstNode>(initializer));
-    return children;
+  void forEachChild(ChildVisitor visit) const override {
+    visit(type);
+    visit(initializer);
   }
 
   std::ostream &print(std::ostream &os, int indent = 0) const override;
@@ -492,8 +595,8 @@ class FieldDecl final : public VarDecl {
 
 public:
   FieldDecl(std::shared_ptr<Modifiers> modifiers, std::shared_ptr<Type> type,
-            std::string name, std::shared_ptr<Expr> initializer,
-            std::shared_ptr<ScopeID> scope, const source::SourceRange &loc,
+            Symbol name, std::shared_ptr<Expr> initializer,
+            ScopeID scope, const source::SourceRange &loc,
             bool allowFinal = false);
 
   // Getters
@@ -513,12 +616,13 @@ class MethodDecl : public Decl,
   std::vector<std::shared_ptr<VarDecl>> localDecls;
   std::shared_ptr<Block> methodBody;
   bool isConstructor_;
+  mutable Symbol signatureSymbol; // see getSignatureSymbol
 
   // Check for explicit this() or super() calls
   void checkSuperThisCalls(std::shared_ptr<Block> block) const;
 
 public:
-  MethodDecl(std::shared_ptr<Modifiers> modifiers, std::string name,
+  MethodDecl(std::shared_ptr<Modifiers> modifiers, Symbol name,
              std::shared_ptr<Type> returnType,
              std::vector<std::shared_ptr<VarDecl>> params, bool isConstructor,
              std::shared_ptr<Block> methodBody, const source::SourceRange loc);
@@ -541,17 +645,15 @@ public:
     }
   }
 
-  std::vector<std::shared_ptr<AstNode>> getChildren() const override {
-    std::vector<std::shared_ptr<AstNode>> children;
-    children.push_back(std::dynamic_pointer_cast<AstNode>(returnType));
+  void forEachChild(ChildVisitor visit) const override {
+    visit(returnType);
     for (const auto &node : params) {
-      children.push_back(std::dynamic_pointer_cast<AstNode>(node));
+      visit(node);
     }
     for (const auto &node : localDecls) {
-      children.push_back(std::dynamic_pointer_cast<AstNode>(node));
+      visit(node);
     }
-    children.push_back(std::dynamic_pointer_cast<AstNode>(methodBody));
-    return children;
+    visit(methodBody);
   }
 
   std::string getSignature() const {
@@ -574,6 +676,14 @@ public:
     return signature;
   }
 
+  // Interned getSignature(), built once. Parameter types print the same
+  // simple name before and after linking, so it doesn't go stale.
+  Symbol getSignatureSymbol() const {
+    if (signatureSymbol.empty())
+      signatureSymbol = Symbol{getSignature()};
+    return signatureSymbol;
+  }
+
   void setParent(std::shared_ptr<CodeBody> parent) override;
 
   std::shared_ptr<Type> getReturnType() { return returnType; }
@@ -612,117 +722,98 @@ class ClassDecl : virtual public CodeBody,
 
   std::unordered_set<std::shared_ptr<MethodDecl>> allMethods;
 
+  // classBodyDecls split by kind, with name lookups. Built once from the
+  // body, call indexMembers() again if the body ever changes.
+  std::vector<std::shared_ptr<FieldDecl>> fields;
+  std::vector<std::shared_ptr<MethodDecl>> methods;
+  std::vector<std::shared_ptr<MethodDecl>> constructors;
+  std::unordered_map<Symbol, size_t> fieldIndex; // into fields
+  std::unordered_map<Symbol, std::shared_ptr<MethodDecl>> methodIndex;
+
+  void indexMembers();
+
+  friend class ASTSerializer;
+
 public:
-  ClassDecl(std::shared_ptr<Modifiers> modifiers, std::string name,
+  ClassDecl(std::shared_ptr<Modifiers> modifiers, Symbol name,
             std::shared_ptr<ReferenceType> superClass,
             std::shared_ptr<ReferenceType> objectType,
             std::vector<std::shared_ptr<ReferenceType>> interfaces,
             std::vector<std::shared_ptr<Decl>> classBodyDecls);
 
-  ClassDecl(std::string name) : Decl{name} {}
+  ClassDecl(Symbol name) : Decl{name} {}
 
   std::ostream &print(std::ostream &os, int indent = 0) const override;
 
-  std::vector<std::shared_ptr<ReferenceType>> getSuperClasses() {
+  const std::vector<std::shared_ptr<ReferenceType>> &
+  getSuperClasses() const {
     return superClasses;
   }
 
-  std::vector<std::shared_ptr<ReferenceType>> getInterfaces() {
+  const std::vector<std::shared_ptr<ReferenceType>> &getInterfaces() const {
     return interfaces;
   }
 
-  std::vector<std::shared_ptr<Decl>> getClassMembers() {
+  const std::vector<std::shared_ptr<Decl>> &getClassMembers() const {
     return classBodyDecls;
   }
 
   std::shared_ptr<Modifiers> getModifiers() { return modifiers; }
 
-  std::vector<std::shared_ptr<FieldDecl>> getFields() const {
-    std::vector<std::shared_ptr<FieldDecl>> fields;
-
-    for (const auto &decl : classBodyDecls) {
-      if (auto fieldDecl = std::dynamic_pointer_cast<FieldDecl>(decl)) {
-        fields.push_back(fieldDecl);
-      }
-    }
-
+  const std::vector<std::shared_ptr<FieldDecl>> &getFields() const {
     return fields;
   }
 
-  std::shared_ptr<FieldDecl> getField(const std::string &fieldName) const {
-    for (const auto &decl : classBodyDecls) {
-      if (auto fieldDecl = std::dynamic_pointer_cast<FieldDecl>(decl)) {
-        if (decl->getName() == fieldName) {
-          return fieldDecl;
-        }
-      }
-    }
-    return nullptr;
+  std::shared_ptr<FieldDecl> getField(Symbol fieldName) const {
+    auto it = fieldIndex.find(fieldName);
+    return it != fieldIndex.end() ? fields[it->second] : nullptr;
   }
 
+  // A field's offset is its position among the fields of this class
   int getFieldOffset(std::shared_ptr<FieldDecl> field) const {
-    int offset = 0;
-    for (const auto &decl : classBodyDecls) {
-      if (auto fieldDecl = std::dynamic_pointer_cast<FieldDecl>(decl)) {
-        if (fieldDecl == field) {
-          return offset;
-        }
-        offset += 1;
-      }
-    }
-
-    return -1;
+    if (!field)
+      return -1;
+    auto it = fieldIndex.find(field->getSymbol());
+    if (it == fieldIndex.end() || fields[it->second] != field)
+      return -1;
+    return static_cast<int>(it->second);
   }
 
-  std::vector<std::shared_ptr<MethodDecl>> getMethods() const {
-    std::vector<std::shared_ptr<MethodDecl>> methods;
-
-    for (const auto &decl : classBodyDecls) {
-      if (auto methodDecl = std::dynamic_pointer_cast<MethodDecl>(decl)) {
-        methods.push_back(methodDecl);
-      }
-    }
-
+  const std::vector<std::shared_ptr<MethodDecl>> &getMethods() const {
     return methods;
   }
 
-  std::shared_ptr<MethodDecl> getMethod(const std::string &methodName) const {
-    for (const auto &decl : classBodyDecls) {
-      if (auto methodDecl = std::dynamic_pointer_cast<MethodDecl>(decl)) {
-        if (methodDecl->getName() == methodName) {
-          return methodDecl;
-        }
-      }
-    }
-
-    return nullptr;
+  // First method declared with that name
+  std::shared_ptr<MethodDecl> getMethod(Symbol methodName) const {
+    auto it = methodIndex.find(methodName);
+    return it != methodIndex.end() ? it->second : nullptr;
   }
 
   std::unordered_set<std::shared_ptr<MethodDecl>> &getAllMethods() {
     return allMethods;
   }
 
-  std::vector<std::shared_ptr<MethodDecl>> getConstructors() const;
+  const std::vector<std::shared_ptr<MethodDecl>> &getConstructors() const {
+    return constructors;
+  }
 
-  std::vector<std::shared_ptr<AstNode>> getChildren() const override {
-    std::vector<std::shared_ptr<AstNode>> children;
+  void forEachChild(ChildVisitor visit) const override {
     for (const auto &node : classBodyDecls) {
-      children.push_back(std::dynamic_pointer_cast<AstNode>(node));
+      visit(node);
     }
     for (const auto &node : interfaces) {
-      children.push_back(std::dynamic_pointer_cast<AstNode>(node));
+      visit(node);
     }
     for (const auto &node : superClasses) {
-      children.push_back(std::dynamic_pointer_cast<AstNode>(node));
+      visit(node);
     }
     // // do we need this
     // for (const auto &node : getFields()) {
-    //   children.push_back(std::dynamic_pointer_cast<AstNode>(node));
+    //   visit(node);
     // }
     // for (const auto &node : getMethods()) {
-    //   children.push_back(std::dynamic_pointer_cast<AstNode>(node));
+    //   visit(node);
     // }
-    return children;
   }
 
   void setParent(std::shared_ptr<CodeBody> parent) override;
@@ -760,42 +851,46 @@ class InterfaceDecl : virtual public CodeBody,
 
   std::unordered_set<std::shared_ptr<MethodDecl>> allMethods;
 
+  // Methods of interfaceBodyDecls, see ClassDecl
+  std::vector<std::shared_ptr<MethodDecl>> methods;
+  std::unordered_map<Symbol, std::shared_ptr<MethodDecl>> methodIndex;
+
+  void indexMembers();
+
+  friend class ASTSerializer;
+
 public:
-  InterfaceDecl(std::shared_ptr<Modifiers> modifiers, std::string name,
+  InterfaceDecl(std::shared_ptr<Modifiers> modifiers, Symbol name,
                 std::vector<std::shared_ptr<ReferenceType>> interfaces,
                 std::shared_ptr<ReferenceType> objectType,
                 std::vector<std::shared_ptr<Decl>> interfaceBody);
 
   std::ostream &print(std::ostream &os, int indent = 0) const;
 
-  std::vector<std::shared_ptr<AstNode>> getChildren() const override {
-    std::vector<std::shared_ptr<AstNode>> children;
+  void forEachChild(ChildVisitor visit) const override {
     for (const auto &node : interfaces) {
-      children.push_back(std::dynamic_pointer_cast<AstNode>(node));
+      visit(node);
     }
     for (const auto &node : interfaceBodyDecls) {
-      children.push_back(std::dynamic_pointer_cast<AstNode>(node));
+      visit(node);
     }
-    return children;
   }
 
-  std::vector<std::shared_ptr<MethodDecl>> getMethods() {
-    std::vector<std::shared_ptr<MethodDecl>> methods;
-
-    for (const auto &decl : interfaceBodyDecls) {
-      if (auto methodDecl = std::dynamic_pointer_cast<MethodDecl>(decl)) {
-        methods.push_back(methodDecl);
-      }
-    }
-
+  const std::vector<std::shared_ptr<MethodDecl>> &getMethods() const {
     return methods;
   }
 
+  // First method declared with that name
+  std::shared_ptr<MethodDecl> getMethod(Symbol methodName) const {
+    auto it = methodIndex.find(methodName);
+    return it != methodIndex.end() ? it->second : nullptr;
+  }
+
   std::unordered_set<std::shared_ptr<MethodDecl>> &getAllMethods() {
     return allMethods;
   }
 
-  std::vector<std::shared_ptr<ReferenceType>> getInterfaces() {
+  const std::vector<std::shared_ptr<ReferenceType>> &getInterfaces() const {
     return interfaces;
   }
 
@@ -828,7 +923,7 @@ class Block : public Stmt {
 public:
   Block() : statements{std::vector<std::shared_ptr<Stmt>>{}} {}
   Block(std::vector<std::shared_ptr<Stmt>> statements)
-      : statements{statements} {}
+      : statements{std::move(statements)} {}
 
   // Getters
   const std::vector<std::shared_ptr<Stmt>> &getStatements() const {
@@ -837,12 +932,10 @@ public:
 
   bool isEmpty() const { return statements.empty(); }
 
-  std::vector<std::shared_ptr<AstNode>> getChildren() const override {
-    std::vector<std::shared_ptr<AstNode>> children;
+  void forEachChild(ChildVisitor visit) const override {
     for (const auto &node : statements) {
-      children.push_back(std::dynamic_pointer_cast<AstNode>(node));
+      visit(node);
     }
-    return children;
   }
 
   std::vector<std::shared_ptr<Expr>> getExprs() const { return {}; }
@@ -865,13 +958,11 @@ public:
   std::shared_ptr<Stmt> getIfBody() const { return ifBody; };
   std::shared_ptr<Stmt> getElseBody() const { return elseBody; };
 
-  std::vector<std::shared_ptr<AstNode>> getChildren() const override {
-    std::vector<std::shared_ptr<AstNode>> children;
-    children.push_back(std::dynamic_pointer_cast<AstNode>(condition));
-    children.push_back(std::dynamic_pointer_cast<AstNode>(ifBody));
+  void forEachChild(ChildVisitor visit) const override {
+    visit(condition);
+    visit(ifBody);
     if (elseBody != nullptr)
-      children.push_back(std::dynamic_pointer_cast<AstNode>(elseBody));
-    return children;
+      visit(elseBody);
   }
 
   std::vector<std::shared_ptr<Expr>> getExprs() const override {
@@ -895,11 +986,9 @@ public:
   std::shared_ptr<Expr> getCondition() const { return condition; };
   std::shared_ptr<Stmt> getWhileBody() const { return whileBody; };
 
-  std::vector<std::shared_ptr<AstNode>> getChildren() const override {
-    std::vector<std::shared_ptr<AstNode>> children;
-    children.push_back(std::dynamic_pointer_cast<AstNode>(condition));
-    children.push_back(std::dynamic_pointer_cast<AstNode>(whileBody));
-    return children;
+  void forEachChild(ChildVisitor visit) const override {
+    visit(condition);
+    visit(whileBody);
   }
 
   std::vector<std::shared_ptr<Expr>> getExprs() const override {
@@ -929,13 +1018,11 @@ public:
   std::shared_ptr<Stmt> getForUpdate() const { return forUpdate; };
   std::shared_ptr<Stmt> getForBody() const { return forBody; };
 
-  std::vector<std::shared_ptr<AstNode>> getChildren() const override {
-    std::vector<std::shared_ptr<AstNode>> children;
-    children.push_back(std::dynamic_pointer_cast<AstNode>(forInit));
-    children.push_back(std::dynamic_pointer_cast<AstNode>(condition));
-    children.push_back(std::dynamic_pointer_cast<AstNode>(forUpdate));
-    children.push_back(std::dynamic_pointer_cast<AstNode>(forBody));
-    return children;
+  void forEachChild(ChildVisitor visit) const override {
+    visit(forInit);
+    visit(condition);
+    visit(forUpdate);
+    visit(forBody);
   }
 
   std::vector<std::shared_ptr<Expr>> getExprs() const override {
@@ -957,10 +1044,8 @@ public:
   // Getters
   std::shared_ptr<Expr> getReturnExpr() const { return returnExpr; };
 
-  std::vector<std::shared_ptr<AstNode>> getChildren() const override {
-    std::vector<std::shared_ptr<AstNode>> children;
-    children.push_back(std::dynamic_pointer_cast<AstNode>(returnExpr));
-    return children;
+  void forEachChild(ChildVisitor visit) const override {
+    visit(returnExpr);
   }
 
   std::vector<std::shared_ptr<Expr>> getExprs() const override {
@@ -990,10 +1075,8 @@ public:
   // Getters
   std::shared_ptr<Expr> getStatementExpr() const { return statementExpr; }
 
-  std::vector<std::shared_ptr<AstNode>> getChildren() const override {
-    std::vector<std::shared_ptr<AstNode>> children;
-    children.push_back(std::dynamic_pointer_cast<AstNode>(statementExpr));
-    return children;
+  void forEachChild(ChildVisitor visit) const override {
+    visit(statementExpr);
   }
 
   std::vector<std::shared_ptr<Expr>> getExprs() const override {
@@ -1021,10 +1104,8 @@ public:
   // Getters
   std::shared_ptr<VarDecl> getDecl() const { return decl; };
 
-  std::vector<std::shared_ptr<AstNode>> getChildren() const override {
-    std::vector<std::shared_ptr<AstNode>> children;
-    children.push_back(std::dynamic_pointer_cast<AstNode>(decl));
-    return children;
+  void forEachChild(ChildVisitor visit) const override {
+    visit(decl);
   }
 
   std::vector<std::shared_ptr<Expr>> getExprs() const override { return {}; }
@@ -1055,48 +1136,47 @@ class BasicType : public Type, public ExprNode {
 public:
   enum class Type { Int, Boolean, Short, Char, Void, Byte, String };
 
-  BasicType(Type type) : type_{type} {}
-  BasicType(parsetree::BasicType::Type type) {
+  static constexpr TypeKind KIND = TypeKind::Basic;
+
+  BasicType(Type type) : parsetree::ast::Type{KIND}, type_{type} {
+    flags = flagsOf(type_);
+  }
+  BasicType(parsetree::BasicType::Type type)
+      : BasicType{fromParseTree(type)} {}
+  BasicType(parsetree::Literal::Type type) : BasicType{fromLiteral(type)} {}
+
+  static Type fromParseTree(parsetree::BasicType::Type type) {
     switch (type) {
     case parsetree::BasicType::Type::Byte:
-      type_ = Type::Byte;
-      break;
+      return Type::Byte;
     case parsetree::BasicType::Type::Short:
-      type_ = Type::Short;
-      break;
+      return Type::Short;
     case parsetree::BasicType::Type::Int:
-      type_ = Type::Int;
-      break;
+      return Type::Int;
     case parsetree::BasicType::Type::Char:
-      type_ = Type::Char;
-      break;
+      return Type::Char;
     case parsetree::BasicType::Type::Boolean:
-      type_ = Type::Boolean;
-      break;
+      return Type::Boolean;
     default:
-      break;
+      return Type::Void;
     }
   }
 
-  BasicType(parsetree::Literal::Type type) {
+  // The null literal is Void
+  static Type fromLiteral(parsetree::Literal::Type type) {
     switch (type) {
     case parsetree::Literal::Type::String:
-      type_ = Type::String;
-      break;
+      return Type::String;
     case parsetree::Literal::Type::Null:
-      type_ = Type::Void;
-      break;
+      return Type::Void;
     case parsetree::Literal::Type::Integer:
-      type_ = Type::Int;
-      break;
+      return Type::Int;
     case parsetree::Literal::Type::Character:
-      type_ = Type::Char;
-      break;
+      return Type::Char;
     case parsetree::Literal::Type::Boolean:
-      type_ = Type::Boolean;
-      break;
+      return Type::Boolean;
     default:
-      break;
+      return Type::Void;
     }
   }
 
@@ -1106,15 +1186,6 @@ public:
   }
 
   bool isResolved() const override { return true; }
-  bool isString() const override { return type_ == Type::String; }
-  bool isPrimitive() const override { return type_ != Type::String; }
-  bool isNull() const override { return type_ == Type::Void; }
-  bool isNumeric() const override {
-    return type_ == Type::Int || type_ == Type::Char || type_ == Type::Short ||
-           type_ == Type::Byte;
-  }
-  bool isCharacter() const override { return type_ == Type::Char; }
-  bool isBoolean() const override { return type_ == Type::Boolean; }
 
   std::ostream &print(std::ostream &os, int indent = 0) const override {
     parsetree::ast::Type::printIndent(os, indent);
@@ -1122,32 +1193,48 @@ public:
     return os;
   }
 
-  bool operator==(const parsetree::ast::Type &other) const override {
-    const BasicType *otherBasic = dynamic_cast<const BasicType *>(&other);
-    if (!otherBasic) {
-      return false;
-    }
-    if (type_ != otherBasic->type_) {
-      return false;
-    }
-    return true;
+protected:
+  bool equals(const parsetree::ast::Type &other) const override {
+    return type_ == static_cast<const BasicType &>(other).type_;
   }
 
 private:
   Type type_;
+
+  static uint8_t flagsOf(Type type) {
+    uint8_t flags = 0;
+    if (type == Type::String)
+      flags |= StringFlag;
+    else
+      flags |= PrimitiveFlag;
+    if (type == Type::Void)
+      flags |= NullFlag;
+    if (type == Type::Int || type == Type::Char || type == Type::Short ||
+        type == Type::Byte)
+      flags |= NumericFlag;
+    if (type == Type::Char)
+      flags |= CharacterFlag;
+    if (type == Type::Boolean)
+      flags |= BooleanFlag;
+    return flags;
+  }
 };
 
 class ArrayType : public Type, public ExprNode {
   std::shared_ptr<Type> elementType;
 
 public:
-  ArrayType(std::shared_ptr<Type> elementType) : elementType{elementType} {}
+  static constexpr TypeKind KIND = TypeKind::Array;
+
+  ArrayType(std::shared_ptr<Type> elementType)
+      : Type{KIND}, elementType{elementType} {
+    flags = ArrayFlag;
+  }
   std::string toString() const override {
     return elementType->toString() + "[]";
   }
 
   bool isResolved() const override { return elementType->isResolved(); }
-  bool isArray() const override { return true; }
 
   std::shared_ptr<Type> getElementType() const { return elementType; }
 
@@ -1160,21 +1247,13 @@ public:
     return os;
   }
 
-  std::vector<std::shared_ptr<AstNode>> getChildren() const override {
-    std::vector<std::shared_ptr<AstNode>> children;
-    children.push_back(std::dynamic_pointer_cast<AstNode>(elementType));
-    return children;
+  void forEachChild(ChildVisitor visit) const override {
+    visit(elementType);
   }
 
-  bool operator==(const Type &other) const override {
-    const ArrayType *otherArrayType = dynamic_cast<const ArrayType *>(&other);
-    if (!otherArrayType) {
-      return false;
-    }
-    if (*elementType != *(otherArrayType->elementType)) {
-      return false;
-    }
-    return true;
+protected:
+  bool equals(const Type &other) const override {
+    return *elementType == *static_cast<const ArrayType &>(other).elementType;
   }
 };
 
@@ -1185,12 +1264,18 @@ class MethodType : public Type {
   std::vector<std::shared_ptr<Type>> paramTypes;
 
 public:
+  static constexpr TypeKind KIND = TypeKind::Method;
+
   MethodType(std::shared_ptr<MethodDecl> method)
-      : Type{}, returnType{method->getReturnType()}, paramTypes{} {
+      : Type{KIND}, returnType{method->getReturnType()}, paramTypes{} {
     for (auto param : method->getParams()) {
       paramTypes.push_back(param->getType());
     }
   }
+  MethodType(std::shared_ptr<Type> returnType,
+             std::vector<std::shared_ptr<Type>> paramTypes)
+      : Type{KIND}, returnType{returnType},
+        paramTypes{std::move(paramTypes)} {}
 
   bool isResolved() const override { return true; }
   std::string toString() const override { return "MethodType"; }
@@ -1227,11 +1312,9 @@ public:
     return os;
   }
 
-  bool operator==(const Type &other) const override {
-    const MethodType *otherMethod = dynamic_cast<const MethodType *>(&other);
-    if (!otherMethod) {
-      return false;
-    }
+protected:
+  bool equals(const Type &other) const override {
+    const auto *otherMethod = static_cast<const MethodType *>(&other);
 
     if (!(*returnType == *(otherMethod->returnType))) {
       return false;
@@ -1251,48 +1334,14 @@ public:
   }
 };
 
-class ScopeID final {
-public:
-  ScopeID(const std::shared_ptr<ScopeID> &parent, int pos)
-      : parent_{parent}, pos_{pos} {}
-
-public:
-  std::shared_ptr<ScopeID> next(std::shared_ptr<ScopeID> parent) const {
-    return std::make_shared<ScopeID>(parent, pos_ + 1);
-  }
-
-  bool canView(std::shared_ptr<ScopeID> other) const {
-    assert(other != nullptr && "Can't view the null scope");
-    // std::cout << "canView: this=" << toString() << " other=" <<
-    // other->toString() << std::endl;
-    if (this->parent_ == other->parent_) {
-      return this->pos_ >= other->pos_;
-    }
-    if (this->parent_) {
-      // std::cout << "canView: this_parent=" << this->parent_->toString() <<
-      // std::endl;
-      return this->parent_->canView(other);
-    }
-    return false;
-  }
-
-  std::shared_ptr<ScopeID> parent() const { return parent_; }
-
-  static std::shared_ptr<ScopeID> New() {
-    return std::make_shared<ScopeID>(nullptr, 0);
-  }
-
-  std::string toString() const {
-    return (parent_ ? parent_->toString() + "." : "") + std::to_string(pos_);
-  }
-
-  friend std::ostream &operator<<(std::ostream &os, const ScopeID &id) {
-    return os << id.toString();
-  }
-
-private:
-  std::shared_ptr<ScopeID> parent_;
-  const int pos_;
-};
+// dynamic_pointer_cast for Types, checks the TypeKind instead of going
+// through RTTI. Null if type is null or of another kind.
+template <typename T>
+  requires(!std::is_same_v<T, UnresolvedType>)
+std::shared_ptr<T> typeCast(const std::shared_ptr<Type> &type) {
+  if (!type || type->getTypeKind() != T::KIND)
+    return nullptr;
+  return std::static_pointer_cast<T>(type);
+}
 
 } // namespace parsetree::ast
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "ast/astContext.hpp"
+#include "ast/astManager.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace parsetree::ast {
+
+class ExprValue;
+
+// Binary snapshot of a fully checked program, i.e. the ASTManager as it is
+// handed to codegen. Lets joosc stop after the static checks and later run
+// just the backend on the same program (--emit-checked-ast and
+// --use-checked-ast).
+//
+// Every node, scope table and Modifiers is written once and referred to by
+// index afterwards, so sharing (the same Type object under several nodes)
+// and the links the checker adds (resolved decls and types, parents,
+// inherited methods) come back as the same object graph.
+//
+// Links that can point "up" or sideways (e.g. an ExprValue resolved to the
+// class it is in) are only an index in the file. They are patched in after
+// everything is read, so reading never needs a node that isn't built yet.
+class ASTSerializer {
+public:
+  // Bump whenever the on-disk layout or the AST shape changes
+  static constexpr uint32_t VERSION = 3;
+
+  static std::string serialize(const ASTManager &manager);
+  // Throws std::runtime_error if the data is malformed or from a different
+  // version
+  static std::shared_ptr<ASTManager> deserialize(std::string_view data);
+
+  static void save(const ASTManager &manager, const std::string &path);
+  static std::shared_ptr<ASTManager> load(const std::string &path);
+
+private:
+  // One per concrete node class
+  enum class Tag : uint8_t {
+    ProgramDecl,
+    ImportDecl,
+    ClassDecl,
+    InterfaceDecl,
+    MethodDecl,
+    FieldDecl,
+    VarDecl,
+    Block,
+    IfStmt,
+    WhileStmt,
+    ForStmt,
+    ReturnStmt,
+    ExpressionStmt,
+    DeclStmt,
+    NullStmt,
+    Expr,
+    ReferenceType,
+    UnresolvedType,
+    BasicType,
+    ArrayType,
+    MethodType,
+    SimpleName,
+    QualifiedName,
+    MemberName,
+    MethodName,
+    TypeNode,
+    ThisNode,
+    Separator,
+    UnOp,
+    BinOp,
+    Assignment,
+    MethodInvocation,
+    ClassCreation,
+    FieldAccess,
+    ArrayCreation,
+    ArrayAccess,
+    Cast,
+    Literal
+  };
+
+  static Tag tagOf(const AstNode &node);
+
+  // Writing ////////////////////////////////////////////////////////////
+
+  std::string out;
+  // Keyed by the most derived object, BasicType and ArrayType have two
+  // AstNode bases
+  std::unordered_map<const void *, uint32_t> nodeIds;
+  std::unordered_set<const void *> written;
+  std::vector<std::shared_ptr<AstNode>> pending; // referenced, not written
+  std::unordered_map<const ScopeTable *, uint32_t> scopeTableIds;
+  std::unordered_map<const Modifiers *, uint32_t> modifierIds;
+
+  uint32_t idOf(const std::shared_ptr<AstNode> &node);
+  // The node is written in place the first time, a back reference after
+  void writeNode(const std::shared_ptr<AstNode> &node);
+  // Only the index, the node itself is written wherever it is owned (or at
+  // the end if nothing owns it)
+  void writeLink(const std::shared_ptr<AstNode> &node);
+  template <typename T>
+  void writeNodes(const std::vector<std::shared_ptr<T>> &nodes);
+  void writeScope(const ScopeID &scope);
+  void writeModifiers(const std::shared_ptr<Modifiers> &modifiers);
+  void writeBody(const std::shared_ptr<AstNode> &node);
+  void writeDecl(const Decl &decl);
+  void writeValue(const ExprValue &value);
+  void writeOp(const ExprOp &op);
+
+  // Reading ////////////////////////////////////////////////////////////
+
+  std::string_view in;
+  ASTContext context;
+  std::vector<std::shared_ptr<AstNode>> nodes; // by id
+  std::vector<std::shared_ptr<ScopeTable>> scopeTables;
+  std::vector<std::shared_ptr<Modifiers>> modifiers;
+  std::vector<std::function<void()>> fixups; // run once all nodes exist
+
+  std::shared_ptr<AstNode> readNode();
+  template <typename T> std::shared_ptr<T> readNodeAs();
+  template <typename T> std::vector<std::shared_ptr<T>> readNodes();
+  // Calls assign with the linked node once everything is read, nothing
+  // happens for a null link
+  template <typename T>
+  void readLink(std::function<void(std::shared_ptr<T>)> assign);
+  template <typename T> std::shared_ptr<T> nodeAt(uint32_t id) const;
+  ScopeID readScope();
+  std::shared_ptr<Modifiers> readModifiers();
+  std::shared_ptr<AstNode> readBody(Tag tag);
+  void readDecl(const std::shared_ptr<Decl> &decl);
+  void readValue(const std::shared_ptr<ExprValue> &value);
+  void readOp(const std::shared_ptr<ExprOp> &op);
+};
+
+} // namespace parsetree::ast
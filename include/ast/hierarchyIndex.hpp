@@ -0,0 +1,191 @@
+#pragma once
+
+#include "ast/astNode.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace parsetree::ast {
+
+// Answers "is A a proper supertype of B" in constant time for the passes
+// after the hierarchy check, instead of walking getSuperClasses() and
+// getInterfaces() on every assignability check and cast.
+//
+// Classes form a tree under Object (each class has one superclass, and the
+// implicit Object entry is an ancestor of it anyway), so a class is a
+// superclass of another iff its pre/post-order interval contains the
+// other's. Interfaces can be reached along many paths, every type keeps a
+// bitset of all its proper superinterfaces instead.
+//
+// Decls that are not in the index (the hardcoded array class) have no
+// supertypes and are no one's supertype, as before.
+class HierarchyIndex {
+public:
+  // The hierarchy must already be checked to be acyclic
+  void build(const std::vector<std::shared_ptr<ProgramDecl>> &asts) {
+    ids.clear();
+    types.clear();
+    superInterfaces.clear();
+
+    size_t numInterfaces = 0;
+    for (const auto &ast : asts) {
+      auto body = ast->getBody();
+      if (auto classDecl = std::dynamic_pointer_cast<ClassDecl>(body)) {
+        ids[classDecl.get()] = types.size();
+        types.push_back({classDecl, nullptr});
+      } else if (auto interfaceDecl =
+                     std::dynamic_pointer_cast<InterfaceDecl>(body)) {
+        ids[interfaceDecl.get()] = types.size();
+        types.push_back({nullptr, interfaceDecl});
+        types.back().interfaceBit = numInterfaces++;
+      }
+    }
+    words = (numInterfaces + 63) / 64;
+    superInterfaces.assign(types.size() * words, 0);
+
+    // Superclass tree
+    std::vector<std::vector<int>> subclasses(types.size());
+    std::vector<int> roots;
+    for (size_t i = 0; i < types.size(); ++i) {
+      if (!types[i].classDecl)
+        continue;
+      int parent = superClassOf(*types[i].classDecl);
+      if (parent < 0)
+        roots.push_back(i);
+      else
+        subclasses[parent].push_back(i);
+    }
+    int counter = 0;
+    for (int root : roots) {
+      number(root, subclasses, counter);
+    }
+
+    // Superinterfaces, nothing to collect without interfaces
+    if (words == 0)
+      return;
+    std::vector<State> states(types.size(), State::Unvisited);
+    for (size_t i = 0; i < types.size(); ++i) {
+      collectSuperInterfaces(i, states);
+    }
+  }
+
+  // Whether super is a proper superclass of child
+  bool isSuperClass(const std::shared_ptr<AstNode> &super,
+                    const std::shared_ptr<AstNode> &child) const {
+    int superId = find(super.get());
+    int childId = find(child.get());
+    if (superId < 0 || childId < 0 || superId == childId)
+      return false;
+    const auto &superType = types[superId];
+    const auto &childType = types[childId];
+    if (!superType.classDecl || !childType.classDecl)
+      return false;
+    return superType.pre <= childType.pre && childType.post <= superType.post;
+  }
+
+  // Whether interface is a proper superinterface of child, which is a class
+  // or an interface
+  bool isSuperInterface(const std::shared_ptr<AstNode> &interface,
+                        const std::shared_ptr<AstNode> &child) const {
+    int interfaceId = find(interface.get());
+    int childId = find(child.get());
+    if (interfaceId < 0 || childId < 0 || !types[interfaceId].interfaceDecl)
+      return false;
+    const size_t bit = types[interfaceId].interfaceBit;
+    return superInterfaces[childId * words + bit / 64] >> (bit % 64) & 1;
+  }
+
+private:
+  struct TypeInfo {
+    std::shared_ptr<ClassDecl> classDecl;
+    std::shared_ptr<InterfaceDecl> interfaceDecl;
+    int pre = -1;
+    int post = -1;
+    size_t interfaceBit = 0; // interfaces only
+  };
+
+  enum class State { Unvisited, Visiting, Done };
+
+  int find(const AstNode *decl) const {
+    if (!decl)
+      return -1;
+    auto it = ids.find(decl);
+    return it != ids.end() ? static_cast<int>(it->second) : -1;
+  }
+
+  int resolvedId(const std::shared_ptr<ReferenceType> &type) const {
+    if (!type)
+      return -1;
+    return find(type->getResolvedDecl().getAstNode().get());
+  }
+
+  // getSuperClasses() is {explicit superclass, Object}, the first one that
+  // resolves is the parent in the tree
+  int superClassOf(const ClassDecl &classDecl) const {
+    for (const auto &superClass : classDecl.getSuperClasses()) {
+      int id = resolvedId(superClass);
+      if (id >= 0 && types[id].classDecl)
+        return id;
+    }
+    return -1;
+  }
+
+  void number(int id, const std::vector<std::vector<int>> &subclasses,
+              int &counter) {
+    types[id].pre = counter++;
+    for (int subclass : subclasses[id]) {
+      number(subclass, subclasses, counter);
+    }
+    types[id].post = counter++;
+  }
+
+  void collectSuperInterfaces(int id, std::vector<State> &states) {
+    if (states[id] == State::Done)
+      return;
+    if (states[id] == State::Visiting)
+      throw std::runtime_error("Cyclic hierarchy when building the index");
+    states[id] = State::Visiting;
+
+    uint64_t *row = &superInterfaces[id * words];
+    auto inherit = [&](int superId) {
+      collectSuperInterfaces(superId, states);
+      const uint64_t *superRow = &superInterfaces[superId * words];
+      for (size_t w = 0; w < words; ++w) {
+        row[w] |= superRow[w];
+      }
+      if (types[superId].interfaceDecl) {
+        const size_t bit = types[superId].interfaceBit;
+        row[bit / 64] |= uint64_t{1} << (bit % 64);
+      }
+    };
+
+    const auto &type = types[id];
+    const auto &interfaces = type.classDecl
+                                 ? type.classDecl->getInterfaces()
+                                 : type.interfaceDecl->getInterfaces();
+    for (const auto &interface : interfaces) {
+      int superId = resolvedId(interface);
+      if (superId >= 0 && types[superId].interfaceDecl)
+        inherit(superId);
+    }
+    if (type.classDecl) {
+      for (const auto &superClass : type.classDecl->getSuperClasses()) {
+        int superId = resolvedId(superClass);
+        if (superId >= 0 && types[superId].classDecl)
+          inherit(superId);
+      }
+    }
+    states[id] = State::Done;
+  }
+
+  std::unordered_map<const AstNode *, size_t> ids;
+  std::vector<TypeInfo> types;
+  size_t words = 0; // per row of superInterfaces
+  // types.size() rows of one bit per interface
+  std::vector<uint64_t> superInterfaces;
+};
+
+} // namespace parsetree::ast
@@ -26,7 +26,7 @@ public:
         }
 
         std::vector<static_check::Decl> copy;
-        for (auto superClass : classDecl->getSuperClasses()) {
+        for (const auto &superClass : classDecl->getSuperClasses()) {
           if (!superClass)
             continue;
           auto temp = superClass->getResolvedDecl();
@@ -58,7 +58,7 @@ public:
             // std::cout << "adding methods from super class "
             //           << classDecl2->getFullName() << " to "
             //           << classDecl->getFullName() << std::endl;
-            auto superMethods = classDecl2->getMethods();
+            const auto &superMethods = classDecl2->getMethods();
             classDecl->getAllMethods().insert(superMethods.begin(),
                                               superMethods.end());
           }
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cassert>
+#include <climits>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace parsetree::ast {
+
+class ASTSerializer;
+
+// The scope tree of one method body, or of the field initializers of one
+// class. Every local declaration and every nested block opens a new scope,
+// in source order, so the ids are a pre-order numbering of the tree and the
+// scopes under a block are the ids from its first scope up to its end.
+class ScopeTable {
+public:
+  static constexpr int NO_PARENT = -1;
+
+  int add(int parent) {
+    scopes.push_back({parent, INT_MAX});
+    return static_cast<int>(scopes.size()) - 1;
+  }
+
+  // Ends the block nested under scope, the next scope added is after it
+  void close(int scope) {
+    scopes[scope].end = static_cast<int>(scopes.size());
+  }
+
+  int parent(int scope) const { return scopes[scope].parent; }
+
+  // One past the last scope in the block nested under scope (or at the top
+  // level for NO_PARENT)
+  int end(int scope) const {
+    return scope == NO_PARENT ? INT_MAX : scopes[scope].end;
+  }
+
+private:
+  friend class ASTSerializer;
+
+  struct Scope {
+    int parent;
+    int end; // INT_MAX while the block is still open
+  };
+  std::vector<Scope> scopes;
+};
+
+// A position in a ScopeTable, i.e. which local declarations are visible.
+// Small enough to copy around, creating one is a push_back into the table
+// of its method instead of an allocation.
+class ScopeID final {
+public:
+  // The null scope
+  ScopeID() = default;
+  ScopeID(std::shared_ptr<ScopeTable> table, int id)
+      : table_{std::move(table)}, id_{id} {}
+
+  explicit operator bool() const { return table_ != nullptr; }
+
+  // First scope of a new table
+  static ScopeID New() {
+    auto table = std::make_shared<ScopeTable>();
+    int id = table->add(ScopeTable::NO_PARENT);
+    return ScopeID{std::move(table), id};
+  }
+
+  // Next scope in the same block
+  ScopeID next() const {
+    return ScopeID{table_, table_->add(table_->parent(id_))};
+  }
+
+  // First scope of a block nested here
+  ScopeID enter() const { return ScopeID{table_, table_->add(id_)}; }
+
+  // Ends the block this scope is in, returns the scope right after it
+  ScopeID exit() const {
+    const int opener = table_->parent(id_);
+    if (opener == ScopeTable::NO_PARENT) {
+      throw std::runtime_error("Tried to exit root scope");
+    }
+    table_->close(opener);
+    return ScopeID{table_, table_->add(table_->parent(opener))};
+  }
+
+  // Whether a declaration at other is visible from here: other is in the
+  // same block as this or an enclosing one, and not after this
+  bool canView(const ScopeID &other) const {
+    assert(other && "Can't view the null scope");
+    if (table_ != other.table_) {
+      return false;
+    }
+    return id_ >= other.id_ && id_ < table_->end(table_->parent(other.id_));
+  }
+
+  ScopeID parent() const {
+    const int parent = table_->parent(id_);
+    return parent == ScopeTable::NO_PARENT ? ScopeID{}
+                                           : ScopeID{table_, parent};
+  }
+  int pos() const { return id_; }
+  const std::shared_ptr<ScopeTable> &table() const { return table_; }
+
+  std::string toString() const {
+    if (!table_) {
+      return "null";
+    }
+    const ScopeID parent = this->parent();
+    return (parent ? parent.toString() + "." : "") + std::to_string(id_);
+  }
+
+  friend std::ostream &operator<<(std::ostream &os, const ScopeID &id) {
+    return os << id.toString();
+  }
+
+private:
+  std::shared_ptr<ScopeTable> table_;
+  int id_ = 0;
+};
+
+} // namespace parsetree::ast
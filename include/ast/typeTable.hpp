@@ -0,0 +1,62 @@
+#pragma once
+
+#include "ast/astContext.hpp"
+#include "ast/astNode.hpp"
+
+#include <array>
+#include <memory>
+#include <unordered_map>
+
+namespace parsetree::ast {
+
+// Hands out one shared object per type: one BasicType per kind, one
+// ArrayType per element type and one resolved ReferenceType per decl. Two
+// types from the same table are equal iff they are the same object, so
+// Type::operator== stops at the pointer compare for them.
+//
+// Types written out in the source are still one object per occurrence (the
+// TypeLinker resolves each on its own), comparing those falls back to their
+// structure.
+//
+// Not thread safe, like the ASTContext the types are allocated from.
+class TypeTable {
+public:
+  std::shared_ptr<BasicType> getBasicType(BasicType::Type type) {
+    auto &basicType = basicTypes[static_cast<size_t>(type)];
+    if (!basicType)
+      basicType = context.make<BasicType>(type);
+    return basicType;
+  }
+
+  // Keyed by the element type object, so int[] is always the same but each
+  // unresolved Foo[] in the source gets its own
+  std::shared_ptr<ArrayType>
+  getArrayType(const std::shared_ptr<Type> &elementType) {
+    auto &arrayType = arrayTypes[elementType.get()];
+    if (!arrayType)
+      arrayType = context.make<ArrayType>(elementType);
+    return arrayType;
+  }
+
+  std::shared_ptr<ReferenceType>
+  getReferenceType(const std::shared_ptr<Decl> &decl) {
+    auto &referenceType = referenceTypes[decl.get()];
+    if (!referenceType) {
+      referenceType = context.make<ReferenceType>(decl);
+      referenceType->setResolvedDecl(static_check::Decl{decl});
+    }
+    return referenceType;
+  }
+
+private:
+  ASTContext context;
+  std::array<std::shared_ptr<BasicType>,
+             magic_enum::enum_count<BasicType::Type>()>
+      basicTypes;
+  // The values hold on to their key, so a key is never reused
+  std::unordered_map<const Type *, std::shared_ptr<ArrayType>> arrayTypes;
+  std::unordered_map<const Decl *, std::shared_ptr<ReferenceType>>
+      referenceTypes;
+};
+
+} // namespace parsetree::ast
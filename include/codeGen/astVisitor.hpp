@@ -42,11 +42,10 @@ public:
       std::cout << "Expr IR: " << std::endl;
       tirExpr->print(std::cout);
     }
-    for (const auto &child : node->getChildren()) {
-      if (!child)
-        continue;
-      visitAST(child);
-    }
+    node->forEachChild([&](const auto &child) {
+      if (child)
+        visitAST(child);
+    });
   }
 
   void visit() {
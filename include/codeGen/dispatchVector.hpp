@@ -94,11 +94,10 @@ class DispatchVectorBuilder {
       addMethodsToGraph(methods);
     }
 
-    for (const auto &child : node->getChildren()) {
-      if (!child)
-        continue;
-      visitAST(child);
-    }
+    node->forEachChild([&](const auto &child) {
+      if (child)
+        visitAST(child);
+    });
   }
 
 public:
@@ -243,11 +242,10 @@ public:
             std::dynamic_pointer_cast<parsetree::ast::ClassDecl>(node)) {
       printClassDV(classDecl);
     } else {
-      for (const auto &child : node->getChildren()) {
-        if (!child)
-          continue;
-        print(child);
-      }
+      node->forEachChild([&](const auto &child) {
+        if (child)
+          print(child);
+      });
     }
   }
 };
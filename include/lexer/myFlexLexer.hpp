@@ -1,6 +1,9 @@
 #pragma once
 
 #include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
 #include <vector>
 #ifndef yyFlexLexer // Prevent multiple inclusion of FlexLexer.h
 #include <FlexLexer.h>
@@ -31,19 +34,59 @@ public:
   template <typename... Args>
   std::shared_ptr<Node> make_node(source::SourceRange loc, Args &&...args) {
     loc.fileID = this->fileID;
-    auto nodePtr = std::make_shared<Node>(loc, std::forward<Args>(args)...);
-    nodes.push_back(nodePtr);
-    return nodePtr;
+    if constexpr (sizeof...(Args) == 1) {
+      // just the node type, no children
+      return allocate<Node>(loc, std::forward<Args>(args)...);
+    } else {
+      return allocate<Node>(arena.get(), loc, std::forward<Args>(args)...);
+    }
   }
 
-  void setFileID(int id) { this->fileID = id; }
+  // Hands back the finished tree through a root that also owns the arena,
+  // so the tree stays valid after the lexer is gone. Everything is freed
+  // in one shot once the root is dropped (after the AST is built).
+  std::shared_ptr<Node> own_tree(std::shared_ptr<Node> root) {
+    if (!root)
+      return root;
+    struct Owner {
+      std::shared_ptr<std::pmr::monotonic_buffer_resource> arena;
+      std::shared_ptr<Node> root; // destroyed before the arena
+    };
+    auto owner = std::make_shared<Owner>(Owner{arena, std::move(root)});
+    return std::shared_ptr<Node>(owner, owner->root.get());
+  }
+
+  // Offsets restart at 0 for every file, so one lexer can be reused
+  void setFileID(int id) {
+    this->fileID = id;
+    yyoffset = 0;
+  }
+
+  // Lex directly out of memory rather than an istream. Nothing is copied, so
+  // the bytes must outlive the lexer.
+  void setInput(std::string_view in) { input = in; }
 
-  std::shared_ptr<Node> make_corrupted(const char *name);
+  // Set by grammar actions that reject a construct the grammar itself
+  // accepts (e.g. casting to a non-type expression), the parse is aborted
+  void set_parse_error(const char *what) { parseError = what; }
+  const char *get_parse_error() const { return parseError; }
+
+  // Set by yyerror. Only the byte range is known here, the caller prints it
+  // once it has the file's line table.
+  void set_syntax_error(const char *what, const source::SourceRange &loc) {
+    syntaxError = what;
+    syntaxErrorLoc = loc;
+    syntaxErrorLoc.fileID = fileID;
+  }
 
   std::shared_ptr<Node> make_operator(Operator::Type type);
 
   std::shared_ptr<Node> make_literal(Literal::Type type, const char *value);
 
+  // After the parse: 2^31 literals are only valid if the grammar negated
+  // them, sets the parse error if one wasn't
+  void check_literals();
+
   std::shared_ptr<Node> make_identifier(const char *name);
 
   std::shared_ptr<Node> make_modifier(Modifier::Type type);
@@ -51,8 +94,37 @@ public:
   std::shared_ptr<Node> make_basic_type(BasicType::Type type);
 
 private:
+  // Parse tree nodes (and their child lists) are bump allocated out of the
+  // arena instead of one heap allocation each. Declared first so it is
+  // destroyed after anything else in the lexer still holding nodes.
+  std::shared_ptr<std::pmr::monotonic_buffer_resource> arena =
+      std::make_shared<std::pmr::monotonic_buffer_resource>();
+
+  template <typename T, typename... Args>
+  std::shared_ptr<T> allocate(Args &&...args) {
+    return std::allocate_shared<T>(
+        std::pmr::polymorphic_allocator<T>{arena.get()},
+        std::forward<Args>(args)...);
+  }
+
+protected:
+  // flex pulls its input through here, serve it from `input`
+  int LexerInput(char *buf, int max_size) override;
+
+private:
+  // debug printing of tokens, implemented in the .l file
+  void print_token(const std::string &token_name,
+                   const std::string &token_value) const;
+
   YYSTYPE yylval;
   YYLTYPE yylloc;
   int fileID = 0;
-  std::vector<std::shared_ptr<Node>> nodes;
+  uint32_t yyoffset = 0; // of the next character, updated by YY_USER_ACTION
+  std::string_view input; // remaining unread input
+  const char *parseError = nullptr;
+  std::string syntaxError;
+  source::SourceRange syntaxErrorLoc;
+  // 2^31 literals seen so far, owned by the arena. Only alive while the
+  // tree holds them, so only read after a successful parse.
+  std::vector<Literal *> signDependentLiterals;
 };
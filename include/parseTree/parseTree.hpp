@@ -2,15 +2,19 @@
 
 #include "3rd_party/magic_enum.hpp"
 #include "sourceNode.hpp"
+#include "symbol.hpp"
 #include <array>
 #include <cassert>
 #include <climits>
+#include <cstdint>
 #include <iostream>
 #include <memory>
+#include <memory_resource>
 #include <stdexcept>
 #include <string>
 #include <string_view>
 #include <type_traits>
+#include <vector>
 
 class myFlexLexer;
 class myBisonParser;
@@ -23,7 +27,6 @@ class Identifier;
 class Operator;
 class Modifier;
 class BasicType;
-class Corrupted;
 
 // The base node in the parse tree.
 struct Node {
@@ -41,7 +44,6 @@ struct Node {
     Modifier,
     Operator,
     Identifier,
-    Corrupted,
     Literal,
 
     ProgramDecl,
@@ -90,21 +92,33 @@ struct Node {
     Cast
   };
 
+  using ChildList = std::pmr::vector<std::shared_ptr<Node>>;
+
   /// leaf nodes
   Node(source::SourceRange loc, Type type)
-      : loc{loc}, type{type}, args{nullptr}, num_args{0} {}
+      : loc{loc}, type{type}, args{}, num_args{0} {}
 
-  // Non leaf nodes
+  // Non leaf nodes, the child list is allocated out of `resource` (the
+  // lexer's parse tree arena)
   template <typename... Args_>
-  Node(source::SourceRange loc, Type type, Args_ &&...args_)
-      : loc{loc}, type{type}, args{std::vector<std::shared_ptr<Node>>{
-                                  std::forward<Args_>(args_)...}},
+  Node(std::pmr::memory_resource *resource, source::SourceRange loc,
+       Type type, Args_ &&...args_)
+      : loc{loc}, type{type},
+        args({std::forward<Args_>(args_)...}, resource),
         num_args{sizeof...(Args_)} {
     static_assert(sizeof...(Args_) > 0, "Must have at least one child");
     static_assert((std::is_convertible_v<Args_, std::shared_ptr<Node>> && ...),
                   "All arguments must be convertible to std::shared_ptr<Node>");
   }
 
+  // Non leaf nodes with an already built child list (used when reloading
+  // cached trees)
+  Node(source::SourceRange loc, Type type,
+       std::vector<std::shared_ptr<Node>> args_)
+      : loc{loc}, type{type}, args{std::make_move_iterator(args_.begin()),
+                                   std::make_move_iterator(args_.end())},
+        num_args{args.size()} {}
+
   size_t num_children() const { return num_args; }
 
   // Gets the child at index i of this child
@@ -118,9 +132,6 @@ struct Node {
     return std::string(magic_enum::enum_name(type));
   }
 
-  // If the node is corrupted, the tree has been corrupted
-  bool is_corrupted() const;
-
   virtual std::ostream &print(std::ostream &os, int depth = 0) const {
     std::string indent(depth * 2, ' ');
     os << indent << "(" << magic_enum::enum_name(type) << std::endl;
@@ -136,29 +147,15 @@ struct Node {
     return os;
   }
 
-  const std::vector<std::shared_ptr<Node>> &children() const { return args; }
+  const ChildList &children() const { return args; }
   source::SourceRange loc;
 
 private:
   Type type;
-  std::vector<std::shared_ptr<Node>> args;
+  ChildList args;
   size_t num_args;
 };
 
-class Corrupted : public Node {
-  friend class ::myFlexLexer;
-  friend class ::myBisonParser;
-  std::string_view name;
-
-public:
-  Corrupted(const char *name) : Node{loc, Node::Type::Corrupted}, name{name} {}
-  std::ostream &print(std::ostream &os, int depth = 0) const override {
-    std::string indent(depth * 2, ' ');
-    os << indent << "(Corrupted: '" << name << "')\n";
-    return os;
-  }
-};
-
 ////////////////////////////////////////////////////////////////////////////////
 
 // A node in the parse tree representing a literal value.
@@ -173,7 +170,10 @@ public:
   // Constructor for Literal
   Literal(Type type, char const *value)
       : Node{loc, Node::Type::Literal}, type{type},
-        isNegative{false}, value{value} {}
+        isNegative{false}, value{value} {
+    if (type == Type::Integer)
+      magnitude = parseMagnitude(this->value);
+  }
 
   // Override printing for this leaf node
   std::ostream &print(std::ostream &os, int depth = 0) const override {
@@ -187,24 +187,26 @@ public:
   }
 
   void setNegative() { isNegative = !isNegative; }
+
+  // Only 2^31 depends on the sign, anything bigger is never valid
   bool isValid() const {
     if (type != Type::Integer) {
       return true;
     }
-    errno = 0;
-    try {
-      const auto x = std::stoll(value);
-
-      if (x > INT_MAX && !isNegative) {
-        return false;
-      }
-      if (-x < INT_MIN && isNegative) {
-        return false;
-      }
-    } catch (const std::exception &) {
-      return false;
+    if (magnitude <= INT_MAX) {
+      return true;
     }
-    return true;
+    return isNegative && magnitude == static_cast<uint64_t>(INT_MAX) + 1;
+  }
+  bool isOutOfRange() const {
+    return type == Type::Integer &&
+           magnitude > static_cast<uint64_t>(INT_MAX) + 1;
+  }
+
+  // Value of a valid integer literal, sign applied
+  int32_t getIntValue() const {
+    return static_cast<int32_t>(isNegative ? -static_cast<int64_t>(magnitude)
+                                           : static_cast<int64_t>(magnitude));
   }
 
   Type getType() const { return type; }
@@ -215,6 +217,22 @@ private:
   Type type;
   bool isNegative;
   std::string value;
+  uint64_t magnitude = 0; // unsigned value of an integer literal
+
+  // The lexer only hands us [0-9]+, so no allocation or exceptions here.
+  // Saturates, anything past UINT64_MAX is out of range either way.
+  static uint64_t parseMagnitude(std::string_view digits) {
+    uint64_t result = 0;
+    for (char c : digits) {
+      const uint64_t digit = c - '0';
+      if (digit > 9)
+        return UINT64_MAX;
+      if (result > (UINT64_MAX - digit) / 10)
+        return UINT64_MAX;
+      result = result * 10 + digit;
+    }
+    return result;
+  }
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -225,10 +243,11 @@ class Identifier : public Node {
   friend class ::myBisonParser;
 
 public:
-  Identifier(std::string name)
+  Identifier(std::string_view name)
       : Node{loc, Node::Type::Identifier}, name{name} {}
 
   const char *get_name() const { return name.c_str(); }
+  Symbol get_symbol() const { return name; }
 
   std::ostream &print(std::ostream &os, int depth = 0) const override {
     std::string indent(depth * 2, ' ');
@@ -237,7 +256,7 @@ public:
   }
 
 private:
-  std::string name;
+  Symbol name; // interned once by the lexer
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "parseTree/parseTree.hpp"
+
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace parsetree {
+
+// On-disk cache of already validated parse trees, keyed by file path and a
+// hash of the file content. Used for the stdlib, which is passed to every
+// joosc invocation unchanged, so lexing and parsing it can be skipped.
+//
+// Only the parse trees are cached: type linking, hierarchy checking and
+// codegen depend on the whole program (e.g. dispatch vector colouring and
+// label numbering change when user classes are added), so they still run.
+class ParseTreeCache {
+public:
+  // Bump whenever the on-disk layout or the parse tree shape changes
+  static constexpr uint32_t VERSION = 3;
+
+  static uint64_t hashContent(std::string_view content);
+
+  // Returns false (and leaves the cache empty) if the file is missing, was
+  // written by a different version, or is malformed
+  bool load(const std::string &cachePath);
+  void save(const std::string &cachePath) const;
+
+  // Returns the cached tree for this file with every location rewritten to
+  // fileID, or nullptr if there is no entry matching the content hash
+  std::shared_ptr<Node> lookup(const std::string &filePath, uint64_t hash,
+                               int fileID) const;
+  void insert(const std::string &filePath, uint64_t hash,
+              std::shared_ptr<Node> tree);
+
+  size_t size() const { return entries.size(); }
+
+private:
+  struct Entry {
+    uint64_t hash;
+    std::string data; // serialized tree
+  };
+  std::unordered_map<std::string, Entry> entries;
+
+  static void writeNode(std::string &out, const std::shared_ptr<Node> &node);
+  static std::shared_ptr<Node> readNode(std::string_view &in, int fileID);
+};
+
+} // namespace parsetree
@@ -17,7 +17,7 @@ class ParseTreeVisitor {
 
 public:
   ParseTreeVisitor(std::shared_ptr<static_check::EnvManager> envManager)
-      : envManager{envManager} {}
+      : envManager{envManager}, context{envManager->context()} {}
 
 private:
   // Basic helper functions
@@ -107,7 +107,7 @@ public:
   // Statement visitors
   struct VariableDecl {
     std::shared_ptr<ast::Type> type;
-    std::string name;
+    Symbol name;
     std::shared_ptr<ast::Expr> init;
   };
   [[nodiscard]] VariableDecl visitLocalDecl(const NodePtr &type,
@@ -161,7 +161,7 @@ public:
   [[nodiscard]] std::vector<std::shared_ptr<ast::ExprNode>>
   visitQualifiedIdentifierInExpr(const NodePtr &node, bool isMethod = false);
 
-  [[nodiscard]] std::vector<std::string>
+  [[nodiscard]] std::vector<Symbol>
   visitUnresolvedTypeExpr(const NodePtr &node);
 
   std::shared_ptr<ast::ExprNode> visitBasicType(const NodePtr &node);
@@ -207,7 +207,7 @@ public:
   [[nodiscard]] std::shared_ptr<ast::UnresolvedType>
   visitReferenceType(const NodePtr &node,
                      std::shared_ptr<ast::UnresolvedType> ast_node = nullptr);
-  [[nodiscard]] std::string visitIdentifier(const NodePtr &node);
+  [[nodiscard]] Symbol visitIdentifier(const NodePtr &node);
   [[nodiscard]] ast::Modifiers
   visitModifierList(const NodePtr &node,
                     ast::Modifiers modifiers = ast::Modifiers{});
@@ -216,5 +216,6 @@ public:
 
 private:
   std::shared_ptr<static_check::EnvManager> envManager;
+  ast::ASTContext &context; // owned by envManager
 };
 } // namespace parsetree
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cstdint>
+#include <fcntl.h>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+// The AVX2 loop is compiled for its own target and picked at runtime, so a
+// plain x86-64 build still uses it on machines that have it
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define JOOS_SCAN_AVX2 1
+#endif
+
+namespace source {
+
+// Read-only view of a whole source file. The file is mmapped where possible
+// so the lexer can read it in place instead of copying it into a
+// std::string and then again into an istringstream.
+class MappedFile {
+public:
+  explicit MappedFile(const std::string &path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      return;
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+      size = st.st_size;
+      if (size == 0) {
+        opened = true;
+      } else {
+        void *addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr != MAP_FAILED) {
+          data = static_cast<const char *>(addr);
+          opened = true;
+        }
+      }
+    }
+    ::close(fd);
+
+    // not a regular file or mmap failed, fall back to reading it
+    if (!opened) {
+      std::ifstream file(path, std::ios::binary);
+      if (!file.is_open())
+        return;
+      fallback.assign(std::istreambuf_iterator<char>(file),
+                      std::istreambuf_iterator<char>());
+      size = 0;
+      opened = true;
+    }
+  }
+
+  ~MappedFile() {
+    if (data)
+      ::munmap(const_cast<char *>(data), size);
+  }
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  bool is_open() const { return opened; }
+
+  std::string_view contents() const {
+    return data ? std::string_view{data, size} : std::string_view{fallback};
+  }
+
+private:
+  const char *data = nullptr;
+  size_t size = 0;
+  bool opened = false;
+  std::string fallback;
+};
+
+namespace detail {
+
+#if defined(JOOS_SCAN_AVX2)
+// Same as the SSE2 loop below, 32 bytes at a time. Stops before the last
+// partial chunk and leaves i there for the narrower loops.
+__attribute__((target("avx2"))) inline bool
+scanAVX2(const char *data, size_t size, size_t &i,
+         std::vector<uint32_t> &lineStarts) {
+  const __m256i newline = _mm256_set1_epi8('\n');
+  __m256i high = _mm256_setzero_si256();
+  for (; i + 32 <= size; i += 32) {
+    __m256i chunk =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+    high = _mm256_or_si256(high, chunk);
+    uint32_t mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, newline));
+    for (; mask; mask &= mask - 1) {
+      lineStarts.push_back(i + __builtin_ctz(mask) + 1);
+    }
+  }
+  return !_mm256_movemask_epi8(high);
+}
+
+inline bool hasAVX2() {
+  static const bool has = __builtin_cpu_supports("avx2");
+  return has;
+}
+#endif
+
+} // namespace detail
+
+// Single pass over a source file before lexing. Returns false if there is
+// any non-ASCII byte, and fills lineStarts with the offset each line starts
+// at (see SourceManager::getLineColumn).
+inline bool scanSource(std::string_view text,
+                       std::vector<uint32_t> &lineStarts) {
+  lineStarts.clear();
+  lineStarts.push_back(0);
+  const char *data = text.data();
+  const size_t size = text.size();
+  size_t i = 0;
+
+#if defined(JOOS_SCAN_AVX2)
+  if (detail::hasAVX2() && !detail::scanAVX2(data, size, i, lineStarts))
+    return false;
+#endif
+
+  // OR every chunk together, the high bit survives if any byte was > 127.
+  // SSE2 is part of x86-64, so this is on in every build there.
+#if defined(__SSE2__)
+  const __m128i newline = _mm_set1_epi8('\n');
+  __m128i high = _mm_setzero_si128();
+  for (; i + 16 <= size; i += 16) {
+    __m128i chunk =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+    high = _mm_or_si128(high, chunk);
+    uint32_t mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, newline));
+    for (; mask; mask &= mask - 1) {
+      lineStarts.push_back(i + __builtin_ctz(mask) + 1);
+    }
+  }
+  if (_mm_movemask_epi8(high))
+    return false;
+#endif
+
+  // scalar tail (or the whole file without SSE2)
+  for (; i < size; ++i) {
+    const auto c = static_cast<unsigned char>(data[i]);
+    if (c > 127)
+      return false;
+    if (c == '\n')
+      lineStarts.push_back(i + 1);
+  }
+  return true;
+}
+
+} // namespace source
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
-#include <unordered_map>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace source {
 // struct SourceLocation
@@ -17,60 +21,105 @@ namespace source {
 //   }
 // };
 
+// Where a node came from, as a byte range of its file. Line and column are
+// only needed for diagnostics, so they are worked out from the file's line
+// table by SourceManager::getLineColumn instead of being tracked by the lexer
+// and stored in every node.
 struct SourceRange {
-  int fileID; // Unique ID assigned by SourceManager
-  int first_line;
-  int last_line;
-  int first_column;
-  int last_column;
+  int fileID = 0;      // Unique ID assigned by SourceManager
+  uint32_t offset = 0; // of the first character
+  uint32_t length = 0; // in bytes
 
-  SourceRange()
-      : fileID(0), first_line(0), last_line(0), first_column(0),
-        last_column(0) {}
+  uint32_t end() const { return offset + length; }
+
+  // From the start of first to the end of last
+  static SourceRange span(const SourceRange &first, const SourceRange &last) {
+    SourceRange range;
+    range.fileID = first.fileID;
+    range.offset = first.offset;
+    range.length = last.end() - first.offset;
+    return range;
+  }
+
+  // Empty range right after loc (e.g. for an empty grammar rule)
+  static SourceRange after(const SourceRange &loc) {
+    SourceRange range;
+    range.fileID = loc.fileID;
+    range.offset = loc.end();
+    return range;
+  }
 
   friend std::ostream &operator<<(std::ostream &os, const SourceRange &range) {
     os << "File ID: " << range.fileID << ", "
-       << "Lines: " << range.first_line << "-" << range.last_line << ", "
-       << "Columns: " << range.first_column << "-" << range.last_column;
+       << "Bytes: " << range.offset << "-" << range.end();
     return os;
   }
 
   bool operator<=(const SourceRange &other) const {
     if (fileID != other.fileID)
       return false;
-    // // if (fileID != other.fileID) return fileID < other.fileID;
-    if (first_line != other.first_line)
-      return first_line <= other.first_line;
-    if (last_line != other.last_line)
-      return last_line <= other.last_line;
-    if (first_column != other.first_column)
-      return first_column <= other.first_column;
-    return last_column <= other.last_column;
+    if (offset != other.offset)
+      return offset <= other.offset;
+    return length <= other.length;
   }
 };
 
 class SourceManager {
-  std::unordered_map<int, std::string> fileTable; // fileID → filename
-  int nextFileID = 1;                             // Auto-incremented file ID
+  struct File {
+    std::string name;
+    // offset of the first character of each line
+    std::vector<uint32_t> lineStarts;
+  };
+  // fileID - 1 → file, IDs are handed out densely from 1
+  std::vector<File> files;
+
+  const File *getFile(int fileID) const {
+    if (fileID < 1 || static_cast<size_t>(fileID) > files.size())
+      return nullptr;
+    return &files[fileID - 1];
+  }
 
 public:
   int addFile(const std::string &filename) {
-    int id = nextFileID++;
-    fileTable[id] = filename;
-    return id;
+    files.push_back({filename, {}});
+    return static_cast<int>(files.size());
   }
 
   std::string getFilename(int fileID) const {
-    auto it = fileTable.find(fileID);
-    return it != fileTable.end() ? it->second : "<unknown>";
+    auto file = getFile(fileID);
+    return file ? file->name : "<unknown>";
   }
 
-  int getFileID() { return nextFileID; }
+  int getFileID() { return static_cast<int>(files.size()) + 1; }
+
+  // Line starts come from scanSource, done once per file before lexing
+  void setLineStarts(int fileID, std::vector<uint32_t> lineStarts) {
+    files[fileID - 1].lineStarts = std::move(lineStarts);
+  }
+
+  size_t getLineCount(int fileID) const {
+    auto file = getFile(fileID);
+    return file ? file->lineStarts.size() : 0;
+  }
+
+  // 1-based line and column of a byte offset into the file, {0, 0} if the
+  // file has no line table
+  std::pair<int, int> getLineColumn(int fileID, uint32_t offset) const {
+    auto file = getFile(fileID);
+    if (!file || file->lineStarts.empty())
+      return {0, 0};
+    const auto &starts = file->lineStarts;
+    auto line = std::upper_bound(starts.begin(), starts.end(), offset) - 1;
+    return {static_cast<int>(line - starts.begin()) + 1,
+            static_cast<int>(offset - *line) + 1};
+  }
 
-  void printRange(const SourceRange &loc) const {
-    std::cout << getFilename(loc.fileID) << " " << loc.first_line << ":"
-              << loc.first_column << " - " << loc.last_line << ":"
-              << loc.last_column << "\n";
+  void printRange(std::ostream &os, const SourceRange &loc) const {
+    auto [firstLine, firstColumn] = getLineColumn(loc.fileID, loc.offset);
+    auto [lastLine, lastColumn] = getLineColumn(
+        loc.fileID, loc.length ? loc.end() - 1 : loc.offset);
+    os << getFilename(loc.fileID) << " " << firstLine << ":" << firstColumn
+       << " - " << lastLine << ":" << lastColumn << "\n";
   }
 };
 } // namespace source
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+namespace parsetree {
+
+// An interned identifier. Every Symbol with the same spelling points at the
+// same entry of a global table, so equality and hashing are a pointer
+// compare instead of a string compare. Entries are never freed, so the
+// string_view / c_str() of a Symbol stays valid for the whole compile.
+class Symbol {
+public:
+  Symbol() : str_{&intern("")} {}
+  explicit Symbol(std::string_view name) : str_{&intern(name)} {}
+
+  const std::string &str() const { return *str_; }
+  std::string_view view() const { return *str_; }
+  const char *c_str() const { return str_->c_str(); }
+  bool empty() const { return str_->empty(); }
+
+  bool operator==(const Symbol &other) const { return str_ == other.str_; }
+  size_t hash() const { return std::hash<const std::string *>{}(str_); }
+
+  friend std::ostream &operator<<(std::ostream &os, const Symbol &symbol) {
+    return os << symbol.str();
+  }
+
+private:
+  const std::string *str_;
+
+  struct TableHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view str) const {
+      return std::hash<std::string_view>{}(str);
+    }
+  };
+
+  // Thread safe, the -j front end interns from several lexers at once
+  static const std::string &intern(std::string_view name) {
+    static std::shared_mutex mutex;
+    // node based, so addresses of entries are stable across rehashes
+    static std::unordered_set<std::string, TableHash, std::equal_to<>> table;
+    {
+      std::shared_lock lock{mutex};
+      if (auto it = table.find(name); it != table.end())
+        return *it;
+    }
+    std::unique_lock lock{mutex};
+    return *table.emplace(name).first;
+  }
+};
+
+} // namespace parsetree
+
+template <> struct std::hash<parsetree::Symbol> {
+  size_t operator()(const parsetree::Symbol &symbol) const noexcept {
+    return symbol.hash();
+  }
+};
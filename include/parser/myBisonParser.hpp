@@ -5,27 +5,44 @@
 
 #include <iostream>
 #include <memory>
-#include <sstream>
+#include <string>
+#include <string_view>
 
 class myBisonParser final {
 public:
-  explicit myBisonParser(const std::string &in) : lexer{}, buffer(nullptr) {
-    auto iss = std::make_unique<std::istringstream>(in);
-    lexer.yy_switch_to_buffer(lexer.yy_create_buffer(iss.get(), in.size()));
-    input_stream = std::move(iss);
+  // The lexer reads straight out of `in` (e.g. a mapped file), nothing is
+  // copied, so the bytes must outlive the parser
+  explicit myBisonParser(std::string_view in) : lexer{} {
+    lexer.setInput(in);
   }
 
   int yylex() { return lexer.yylex(); }
 
   int parse(std::shared_ptr<parsetree::Node> &ret) {
     ret = nullptr;
-    return yyparse(&ret, lexer);
+    int result = yyparse(&ret, lexer);
+    // A failed parse has already dropped the popped literals, and the
+    // parse fails either way
+    if (result == 0)
+      lexer.check_literals();
+    ret = lexer.own_tree(std::move(ret));
+    return result;
   }
 
   void setFileID(int id) { lexer.setFileID(id); }
 
+  // Whether the parse was aborted because a grammar action rejected an
+  // invalid construct, rather than a syntax error. Also set for integer
+  // literals out of range.
+  bool hasInvalidConstruct() const { return lexer.get_parse_error(); }
+
+  // bison's message for a syntax error and where it happened, the message
+  // is empty if there was none
+  const std::string &getSyntaxError() const { return lexer.syntaxError; }
+  source::SourceRange getSyntaxErrorLoc() const {
+    return lexer.syntaxErrorLoc;
+  }
+
 private:
   myFlexLexer lexer;
-  std::shared_ptr<yy_buffer_state> buffer;
-  std::unique_ptr<std::istringstream> input_stream;
 };
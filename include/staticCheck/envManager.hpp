@@ -1,6 +1,8 @@
 #pragma once
 
 #include "ast/ast.hpp"
+#include "ast/astContext.hpp"
+#include "ast/typeTable.hpp"
 #include "parseTree/parseTree.hpp"
 #include "parseTree/sourceNode.hpp"
 #include <ranges>
@@ -12,9 +14,9 @@ public:
   EnvManager() {
     // everything inherits java.lang.Object
     objectType = BuildUnresolvedType();
-    objectType->addIdentifier("java");
-    objectType->addIdentifier("lang");
-    objectType->addIdentifier("Object");
+    objectType->addIdentifier(parsetree::Symbol{"java"});
+    objectType->addIdentifier(parsetree::Symbol{"lang"});
+    objectType->addIdentifier(parsetree::Symbol{"Object"});
   }
 
   [[nodiscard]] std::shared_ptr<parsetree::ast::ProgramDecl> BuildProgramDecl(
@@ -24,41 +26,38 @@ public:
 
   [[nodiscard]] std::shared_ptr<parsetree::ast::ClassDecl> BuildClassDecl(
       const std::shared_ptr<parsetree::ast::Modifiers> &modifiers,
-      std::string name,
+      parsetree::Symbol name,
       const std::shared_ptr<parsetree::ast::ReferenceType> &super,
-      const std::vector<std::shared_ptr<parsetree::ast::ReferenceType>>
-          &interfaces,
-      const std::vector<std::shared_ptr<parsetree::ast::Decl>> &classBodyDecls);
+      std::vector<std::shared_ptr<parsetree::ast::ReferenceType>> interfaces,
+      std::vector<std::shared_ptr<parsetree::ast::Decl>> classBodyDecls);
 
   [[nodiscard]] std::shared_ptr<parsetree::ast::FieldDecl>
   BuildFieldDecl(const std::shared_ptr<parsetree::ast::Modifiers> &modifiers,
                  const std::shared_ptr<parsetree::ast::Type> &type,
-                 std::string name,
+                 parsetree::Symbol name,
                  const std::shared_ptr<parsetree::ast::Expr> &init,
                  const source::SourceRange &loc, bool allowFinal = false);
 
   [[nodiscard]] std::shared_ptr<parsetree::ast::MethodDecl> BuildMethodDecl(
       const std::shared_ptr<parsetree::ast::Modifiers> &modifiers,
-      std::string name, const std::shared_ptr<parsetree::ast::Type> &returnType,
-      const std::vector<std::shared_ptr<parsetree::ast::VarDecl>> &params,
+      parsetree::Symbol name,
+      const std::shared_ptr<parsetree::ast::Type> &returnType,
+      std::vector<std::shared_ptr<parsetree::ast::VarDecl>> params,
       bool isConstructor,
       const std::shared_ptr<parsetree::ast::Block> &methodBody,
       const source::SourceRange &loc);
 
   [[nodiscard]] std::shared_ptr<parsetree::ast::VarDecl> BuildVarDecl(
-      const std::shared_ptr<parsetree::ast::Type> &type, std::string name,
-      const std::shared_ptr<parsetree::ast::ScopeID> &scopeID,
-      const source::SourceRange &loc,
+      const std::shared_ptr<parsetree::ast::Type> &type, parsetree::Symbol name,
+      const parsetree::ast::ScopeID &scopeID, const source::SourceRange &loc,
       const std::shared_ptr<parsetree::ast::Expr> &initializer = nullptr);
 
   [[nodiscard]] std::shared_ptr<parsetree::ast::InterfaceDecl>
   BuildInterfaceDecl(
       const std::shared_ptr<parsetree::ast::Modifiers> &modifiers,
-      std::string name,
-      const std::vector<std::shared_ptr<parsetree::ast::ReferenceType>>
-          &extends,
-      const std::vector<std::shared_ptr<parsetree::ast::Decl>>
-          &interfaceBodyDecls);
+      parsetree::Symbol name,
+      std::vector<std::shared_ptr<parsetree::ast::ReferenceType>> extends,
+      std::vector<std::shared_ptr<parsetree::ast::Decl>> interfaceBodyDecls);
 
   [[nodiscard]] std::shared_ptr<parsetree::ast::ReferenceType>
   BuildQualifiedIdentifier(const std::vector<std::string> &identifiers);
@@ -78,6 +77,9 @@ public:
   [[nodiscard]] std::shared_ptr<parsetree::ast::UnresolvedType>
   BuildUnresolvedType();
 
+  // Every node built for this file comes out of here
+  parsetree::ast::ASTContext &context() noexcept { return context_; }
+
   void ClearLocalScope() noexcept {
     localDecls_.clear();
     localDeclStack_.clear();
@@ -88,7 +90,7 @@ public:
   auto getAllDecls() const noexcept { return std::views::all(localDecls_); }
 
   bool AddToLocalScope(std::shared_ptr<parsetree::ast::VarDecl> decl) {
-    const std::string name = decl->getName();
+    const auto name = decl->getSymbol();
     if (localScope_.contains(name)) {
       return false;
     }
@@ -99,36 +101,34 @@ public:
   }
 
   [[nodiscard]] std::size_t EnterNewScope() {
-    currentScope_ = currentScope_->next(currentScope_);
+    currentScope_ = currentScope_.enter();
     return localDeclStack_.size();
   }
 
   void ExitScope(std::size_t size) {
     for (auto i = localDeclStack_.size(); i > size; --i) {
-      localScope_.erase(localDeclStack_[i - 1]->getName());
+      localScope_.erase(localDeclStack_[i - 1]->getSymbol());
     }
     localDeclStack_.resize(size);
-    if (currentScope_->parent() == nullptr) {
-      throw std::runtime_error("Tried to exit root scope");
-    }
-    currentScope_ = currentScope_->next(currentScope_->parent()->parent());
+    currentScope_ = currentScope_.exit();
   }
 
-  std::shared_ptr<parsetree::ast::ScopeID> NextScopeID() {
-    currentScope_ = currentScope_->next(currentScope_->parent());
+  parsetree::ast::ScopeID NextScopeID() {
+    currentScope_ = currentScope_.next();
     return currentScope_;
   }
 
-  std::shared_ptr<parsetree::ast::ScopeID> CurrentScopeID() const {
+  const parsetree::ast::ScopeID &CurrentScopeID() const {
     return currentScope_;
   }
 
-  std::shared_ptr<parsetree::ast::ScopeID> NextFieldScopeID() {
-    currentFieldScope_ = currentFieldScope_->next(currentFieldScope_);
+  // Each field is visible to the initializers of the fields after it
+  parsetree::ast::ScopeID NextFieldScopeID() {
+    currentFieldScope_ = currentFieldScope_.enter();
     return currentFieldScope_;
   }
 
-  std::shared_ptr<parsetree::ast::ScopeID> CurrentFieldScopeID() const {
+  const parsetree::ast::ScopeID &CurrentFieldScopeID() const {
     return currentFieldScope_;
   }
 
@@ -137,12 +137,14 @@ public:
   }
 
 private:
+  parsetree::ast::ASTContext context_;
+  parsetree::ast::TypeTable types_; // basic and array types are shared
   std::vector<std::shared_ptr<parsetree::ast::VarDecl>> localDecls_;
   std::vector<std::shared_ptr<parsetree::ast::VarDecl>> localDeclStack_;
-  std::unordered_set<std::string> localScope_;
+  std::unordered_set<parsetree::Symbol> localScope_;
   std::shared_ptr<parsetree::ast::UnresolvedType> objectType;
-  std::shared_ptr<parsetree::ast::ScopeID> currentScope_;
-  std::shared_ptr<parsetree::ast::ScopeID> currentFieldScope_;
+  parsetree::ast::ScopeID currentScope_;
+  parsetree::ast::ScopeID currentFieldScope_;
 };
 
 } // namespace static_check
\ No newline at end of file
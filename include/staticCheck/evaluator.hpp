@@ -48,8 +48,8 @@ protected:
 
 public:
   T evaluate(std::shared_ptr<parsetree::ast::Expr> expr) {
-    auto exprNodes = expr->getExprNodes();
-    return evaluateList(exprNodes);
+    // walk the expression's own RPN, no copy
+    return evaluateList(expr->getExprNodes());
   }
 
   virtual T
@@ -57,27 +57,39 @@ public:
     while (!op_stack.empty())
       popStack();
 
+    using Kind = parsetree::ast::ExprNode::Kind;
     for (const auto &node : list) {
-      if (auto value =
-              std::dynamic_pointer_cast<parsetree::ast::ExprValue>(node)) {
+      // The kind is fixed at construction, so the static casts are safe
+      switch (node->getKind()) {
+      case Kind::Value: {
+        auto value = std::static_pointer_cast<parsetree::ast::ExprValue>(node);
         op_stack.push(mapValue(value));
-      } else if (auto unary =
-                     std::dynamic_pointer_cast<parsetree::ast::UnOp>(node)) {
+        break;
+      }
+      case Kind::UnOp: {
+        auto unary = std::static_pointer_cast<parsetree::ast::UnOp>(node);
         auto rhs = popStack();
         op_stack.push(evalUnOp(unary, rhs));
-      } else if (auto binary =
-                     std::dynamic_pointer_cast<parsetree::ast::BinOp>(node)) {
+        break;
+      }
+      case Kind::BinOp: {
+        auto binary = std::static_pointer_cast<parsetree::ast::BinOp>(node);
         auto rhs = popStack();
         auto lhs = popStack();
         op_stack.push(evalBinOp(binary, lhs, rhs));
-      } else if (auto field =
-                     std::dynamic_pointer_cast<parsetree::ast::FieldAccess>(
-                         node)) {
+        break;
+      }
+      case Kind::FieldAccess: {
+        auto field =
+            std::static_pointer_cast<parsetree::ast::FieldAccess>(node);
         auto rhs = popStack();
         auto lhs = popStack();
         op_stack.push(evalFieldAccess(field, lhs, rhs));
-      } else if (auto method = std::dynamic_pointer_cast<
-                     parsetree::ast::MethodInvocation>(node)) {
+        break;
+      }
+      case Kind::MethodInvocation: {
+        auto method =
+            std::static_pointer_cast<parsetree::ast::MethodInvocation>(node);
         // Note: reverse order
         std::vector<T> args;
         if (method->getNumArgs() > 1) {
@@ -87,9 +99,11 @@ public:
         }
         auto method_name = popStack();
         op_stack.push(evalMethodInvocation(method, method_name, args));
-      } else if (auto newObj =
-                     std::dynamic_pointer_cast<parsetree::ast::ClassCreation>(
-                         node)) {
+        break;
+      }
+      case Kind::ClassCreation: {
+        auto newObj =
+            std::static_pointer_cast<parsetree::ast::ClassCreation>(node);
         std::vector<T> args;
         if (newObj->getNumArgs() > 1) {
           for (int i = 0; i < newObj->getNumArgs() - 1; ++i) {
@@ -98,30 +112,40 @@ public:
         }
         auto type = popStack();
         op_stack.push(evalNewObject(newObj, type, args));
-      } else if (auto array =
-                     std::dynamic_pointer_cast<parsetree::ast::ArrayCreation>(
-                         node)) {
+        break;
+      }
+      case Kind::ArrayCreation: {
+        auto array =
+            std::static_pointer_cast<parsetree::ast::ArrayCreation>(node);
         auto size = popStack();
         auto type = popStack();
         op_stack.push(evalNewArray(array, type, size));
-      } else if (auto access =
-                     std::dynamic_pointer_cast<parsetree::ast::ArrayAccess>(
-                         node)) {
+        break;
+      }
+      case Kind::ArrayAccess: {
+        auto access =
+            std::static_pointer_cast<parsetree::ast::ArrayAccess>(node);
         auto index = popStack();
         auto array = popStack();
         op_stack.push(evalArrayAccess(access, array, index));
-      } else if (auto cast =
-                     std::dynamic_pointer_cast<parsetree::ast::Cast>(node)) {
+        break;
+      }
+      case Kind::Cast: {
+        auto cast = std::static_pointer_cast<parsetree::ast::Cast>(node);
         auto value = popStack();
         auto type = popStack();
         op_stack.push(evalCast(cast, type, value));
-      } else if (auto assignment =
-                     std::dynamic_pointer_cast<parsetree::ast::Assignment>(
-                         node)) {
+        break;
+      }
+      case Kind::Assignment: {
+        auto assignment =
+            std::static_pointer_cast<parsetree::ast::Assignment>(node);
         auto rhs = popStack();
         auto lhs = popStack();
         op_stack.push(evalAssignment(assignment, lhs, rhs));
-      } else {
+        break;
+      }
+      default:
         node->print(std::cout);
         throw std::runtime_error("Unknown node type in evalList!");
       }
@@ -124,7 +124,7 @@ public:
                std::shared_ptr<TypeResolver> typeResolver)
       : astManager(astManager), hierarchyChecker(hierarchyChecker),
         typeLinker(typeLinker), typeResolver(typeResolver) {
-    staticResolver = std::make_shared<static_check::StaticResolver>();
+    staticResolver = std::make_shared<static_check::StaticResolver>(astManager);
     staticState = StaticResolverState();
   }
   void BeginProgram(std::shared_ptr<parsetree::ast::ProgramDecl> programDecl) {
@@ -182,7 +182,7 @@ private:
 
   std::shared_ptr<parsetree::ast::Decl>
   lookupNamedDecl(std::shared_ptr<parsetree::ast::CodeBody> ctx,
-                  std::string name, const source::SourceRange loc);
+                  parsetree::Symbol name, const source::SourceRange loc);
 
   std::shared_ptr<parsetree::ast::Decl>
   reclassifyDecl(std::shared_ptr<parsetree::ast::CodeBody> ctx,
@@ -209,7 +209,7 @@ private:
   std::shared_ptr<parsetree::ast::CodeBody>
   getMethodParent(std::shared_ptr<ExprNameLinked> method) const;
   std::shared_ptr<parsetree::ast::MethodDecl> resolveMethodOverload(
-      std::shared_ptr<parsetree::ast::CodeBody> ctx, std::string name,
+      std::shared_ptr<parsetree::ast::CodeBody> ctx, parsetree::Symbol name,
       const std::vector<std::shared_ptr<parsetree::ast::Type>> &argTypes,
       const source::SourceRange loc, bool isConstructor);
   bool areParameterTypesApplicable(
@@ -226,7 +226,7 @@ private:
   std::shared_ptr<StaticResolver> staticResolver;
   std::shared_ptr<parsetree::ast::ProgramDecl> currentProgram;
   std::shared_ptr<parsetree::ast::CodeBody> currentContext;
-  std::shared_ptr<parsetree::ast::ScopeID> currentScope;
+  parsetree::ast::ScopeID currentScope;
   std::shared_ptr<parsetree::ast::ClassDecl> currentClass;
   std::shared_ptr<parsetree::ast::InterfaceDecl> currentInterface;
   StaticResolverState staticState;
@@ -9,12 +9,12 @@ public:
   void checkField(const std::shared_ptr<parsetree::ast::FieldDecl> node) {
     if (!node->hasInit())
       return;
-    auto exprNodes = node->getInitializer()->getExprNodes();
+    const auto &exprNodes = node->getInitializer()->getExprNodes();
     // std::cout << "for field " << node->getName()
     //           << " we have expr nodes: " << std::endl;
     // node->getInitializer()->print(std::cout);
 
-    for (auto exprNode : exprNodes) {
+    for (const auto &exprNode : exprNodes) {
       if (std::dynamic_pointer_cast<parsetree::ast::MethodName>(exprNode)) {
         continue;
       }
@@ -69,8 +69,8 @@ public:
     if (!node->hasInit())
       throw std::runtime_error("local variable " + node->getName() +
                                " has no initializer");
-    auto exprNodes = node->getInitializer()->getExprNodes();
-    for (auto exprNode : exprNodes) {
+    const auto &exprNodes = node->getInitializer()->getExprNodes();
+    for (const auto &exprNode : exprNodes) {
       if (auto member =
               std::dynamic_pointer_cast<parsetree::ast::MemberName>(exprNode)) {
         if (!member->isDeclResolved())
@@ -98,11 +98,10 @@ public:
         checkLocalVar(localDecl);
       }
     }
-    for (const auto &child : node->getChildren()) {
-      if (!child)
-        continue;
-      checkAST(child);
-    }
+    node->forEachChild([&](const auto &child) {
+      if (child)
+        checkAST(child);
+    });
   }
 
   void check(std::shared_ptr<parsetree::ast::ASTManager> astManager) {
@@ -7,15 +7,37 @@
 namespace static_check {
 
 struct InheritedMethodsResult {
-  std::unordered_map<std::string, std::shared_ptr<parsetree::ast::MethodDecl>>
+  std::unordered_map<parsetree::Symbol,
+                     std::shared_ptr<parsetree::ast::MethodDecl>>
       abstractMethods;
-  std::unordered_map<std::string, std::shared_ptr<parsetree::ast::MethodDecl>>
+  std::unordered_map<parsetree::Symbol,
+                     std::shared_ptr<parsetree::ast::MethodDecl>>
       methods;
-  bool success;
+  bool success = false;
 };
 
 class HierarchyCheck {
+  using FieldMap =
+      std::unordered_map<parsetree::Symbol,
+                         std::shared_ptr<parsetree::ast::FieldDecl>>;
+
+  // Everything a class or interface inherits, built once per decl from the
+  // tables of its supertypes
+  struct MemberTable {
+    // Inherited and declared methods, by signature
+    InheritedMethodsResult methods;
+    // Abstract signatures that a concrete method implements
+    std::unordered_set<parsetree::Symbol> implements;
+    // Whether the last declaration of each signature, in the order the
+    // hierarchy is walked, was abstract
+    std::unordered_map<parsetree::Symbol, bool> lastAbstract;
+    // Fields of the superclasses, and those plus the declared ones
+    FieldMap inheritedFields;
+    FieldMap fields;
+  };
+
   std::shared_ptr<Package> rootPackage;
+  std::unordered_map<const parsetree::ast::AstNode *, MemberTable> tables;
 
   bool isClass(std::shared_ptr<parsetree::ast::AstNode> decl) {
     return !!dynamic_pointer_cast<parsetree::ast::ClassDecl>(decl);
@@ -266,15 +288,15 @@ class HierarchyCheck {
             std::dynamic_pointer_cast<parsetree::ast::ClassDecl>(astNode)) {
 
       // Check to see if class contains duplicate methods or constructors
-      std::vector<std::unordered_set<std::string>> sameClassSignatures(
-          2, std::unordered_set<std::string>());
+      std::vector<std::unordered_set<parsetree::Symbol>> sameClassSignatures(
+          2, std::unordered_set<parsetree::Symbol>());
       for (auto &method : classDecl->getMethods()) {
         // Continue if method is nullptr
         if (!method)
           continue;
         // Differentiate check/store depending on if constructor or not
         int index = method->isConstructor() ? 1 : 0;
-        std::string signature = method->getSignature();
+        parsetree::Symbol signature = method->getSignatureSymbol();
         if (sameClassSignatures[index].count(signature))
           return false;
         sameClassSignatures[index].insert(signature);
@@ -284,13 +306,13 @@ class HierarchyCheck {
                        astNode)) {
 
       // Check to see if interface contains duplicate methods
-      std::unordered_set<std::string> sameClassMethodSignatures;
+      std::unordered_set<parsetree::Symbol> sameClassMethodSignatures;
       for (auto &method : interfaceDecl->getMethods()) {
         // Continue if method is nullptr
         if (!method)
           continue;
         // Check/store method signatures
-        std::string signature = method->getSignature();
+        parsetree::Symbol signature = method->getSignatureSymbol();
         if (sameClassMethodSignatures.count(signature))
           return false;
         sameClassMethodSignatures.insert(signature);
@@ -307,14 +329,102 @@ class HierarchyCheck {
     return method->getReturnType()->toString();
   }
 
-  bool getInheritedMethods(
-      std::shared_ptr<parsetree::ast::Decl> astNode,
-      std::unordered_map<std::string,
-                         std::shared_ptr<parsetree::ast::MethodDecl>>
-          &abstractMethodMap,
-      std::unordered_map<
-          std::string, std::shared_ptr<parsetree::ast::MethodDecl>> &methodMap,
-      std::unordered_set<std::string> &implements) {
+  // Whether method has the same return type as the methods with its
+  // signature already in table
+  bool matchesReturnType(MemberTable &table, parsetree::Symbol signature,
+                         std::shared_ptr<parsetree::ast::MethodDecl> method) {
+    auto &abstractMethodMap = table.methods.abstractMethods;
+    auto &methodMap = table.methods.methods;
+    if (abstractMethodMap.count(signature) &&
+        getSafeReturnType(abstractMethodMap[signature]) !=
+            getSafeReturnType(method))
+      return false;
+    if (methodMap.count(signature) &&
+        getSafeReturnType(methodMap[signature]) != getSafeReturnType(method))
+      return false;
+    return true;
+  }
+
+  // Replays the method declarations under a supertype on top of table, the
+  // same way walking the supertype's hierarchy again would
+  bool inheritMethods(MemberTable &table, const MemberTable &super) {
+    if (!super.methods.success)
+      return false;
+    auto &abstractMethodMap = table.methods.abstractMethods;
+    auto &methodMap = table.methods.methods;
+    for (const auto &[signature, isAbstract] : super.lastAbstract) {
+      auto abstractIt = super.methods.abstractMethods.find(signature);
+      auto methodIt = super.methods.methods.find(signature);
+      // Everything under super with this signature has the same return type,
+      // so comparing its first declarations is enough
+      if (abstractIt != super.methods.abstractMethods.end() &&
+          !matchesReturnType(table, signature, abstractIt->second))
+        return false;
+      if (methodIt != super.methods.methods.end() &&
+          !matchesReturnType(table, signature, methodIt->second))
+        return false;
+      bool wasAbstract = abstractMethodMap.count(signature);
+      if (abstractIt != super.methods.abstractMethods.end())
+        abstractMethodMap.try_emplace(signature, abstractIt->second);
+      if (methodIt != super.methods.methods.end())
+        methodMap.try_emplace(signature, methodIt->second);
+      // The last declaration under super decides: an abstract one needs to
+      // be implemented again, a concrete one implements whatever abstract
+      // declaration came before it
+      if (isAbstract)
+        table.implements.erase(signature);
+      else if (wasAbstract || super.implements.count(signature))
+        table.implements.insert(signature);
+      table.lastAbstract[signature] = isAbstract;
+    }
+    return true;
+  }
+
+  void inheritFields(MemberTable &table, const MemberTable &super) {
+    for (const auto &[symbol, field] : super.fields) {
+      table.inheritedFields.try_emplace(symbol, field);
+    }
+  }
+
+  // Adds a method declared in the class or interface itself
+  bool declareMethod(MemberTable &table,
+                     std::shared_ptr<parsetree::ast::MethodDecl> method,
+                     bool isAbstract) {
+    auto &abstractMethodMap = table.methods.abstractMethods;
+    auto &methodMap = table.methods.methods;
+    parsetree::Symbol signature = method->getSignatureSymbol();
+    // Some inherited functions have same signature but different return
+    // types
+    if (!matchesReturnType(table, signature, method))
+      return false;
+    if (isAbstract) {
+      // Add to map if not exists yet
+      abstractMethodMap.try_emplace(signature, method);
+      // New abstract declaration means that it needs to be implemented by
+      // child node
+      table.implements.erase(signature);
+    } else {
+      // Add to map if not exists yet
+      methodMap.try_emplace(signature, method);
+      // If abstract signature exists, this method implements it
+      if (abstractMethodMap.count(signature))
+        table.implements.insert(signature);
+    }
+    table.lastAbstract[signature] = isAbstract;
+    return true;
+  }
+
+  // Builds the table of astNode from the tables of its supertypes, each
+  // table is built once and reused by every subtype and check
+  const MemberTable &
+  getMemberTable(std::shared_ptr<parsetree::ast::Decl> astNode) {
+    auto [it, inserted] = tables.try_emplace(astNode.get());
+    MemberTable &table = it->second;
+    // A table still being built (only on a cyclic hierarchy) reads as failed
+    if (!inserted)
+      return table;
+
+    bool success = true;
     if (auto classDecl =
             std::dynamic_pointer_cast<parsetree::ast::ClassDecl>(astNode)) {
       for (auto &superInterface : classDecl->getInterfaces()) {
@@ -323,48 +433,30 @@ class HierarchyCheck {
         auto superInterfaceDecl =
             std::dynamic_pointer_cast<parsetree::ast::InterfaceDecl>(
                 superInterface->getResolvedDecl().getAstNode());
-        if (superInterfaceDecl &&
-            !getInheritedMethods(superInterfaceDecl, abstractMethodMap,
-                                 methodMap, implements))
-          return false;
+        if (superInterfaceDecl && success)
+          success = inheritMethods(table, getMemberTable(superInterfaceDecl));
       }
       for (auto &superClass : sanitizedSuperClasses(classDecl)) {
-        if (!getInheritedMethods(superClass, abstractMethodMap, methodMap,
-                                 implements))
-          return false;
+        if (!superClass)
+          continue;
+        const auto &superTable = getMemberTable(superClass);
+        success = success && inheritMethods(table, superTable);
+        inheritFields(table, superTable);
       }
       // Resolve current classes's methods
       for (auto &method : classDecl->getMethods()) {
+        if (!success)
+          break;
         if (!method || method->isConstructor())
           continue;
-        std::string signature = method->getSignature();
-        // Some inherited functions have same signature but different return
-        // types
-        if (abstractMethodMap.count(signature) &&
-            getSafeReturnType(abstractMethodMap[signature]) !=
-                getSafeReturnType(method))
-          return false;
-        if (methodMap.count(signature) &&
-            getSafeReturnType(methodMap[signature]) !=
-                getSafeReturnType(method))
-          return false;
-        // Handle abstract method;
-        if (method->getModifiers() && method->getModifiers()->isAbstract()) {
-          // Add to map if not exists yet
-          if (!abstractMethodMap.count(signature))
-            abstractMethodMap[signature] = method;
-          // New abstract declaration means that it needs to be implemented by
-          // child node
-          implements.erase(signature);
-        } else if (!method->isConstructor()) {
-          // Add to map if not exists yet
-          if (!methodMap.count(signature))
-            methodMap[signature] = method;
-          // If abstract signature exists, this method implements it
-          if (abstractMethodMap.count(signature)) {
-            implements.insert(signature);
-          }
-        }
+        success = declareMethod(table, method,
+                                method->getModifiers() &&
+                                    method->getModifiers()->isAbstract());
+      }
+      table.fields = table.inheritedFields;
+      for (auto &field : classDecl->getFields()) {
+        if (field)
+          table.fields.try_emplace(field->getSymbol(), field);
       }
     } else if (auto interfaceDecl =
                    std::dynamic_pointer_cast<parsetree::ast::InterfaceDecl>(
@@ -376,74 +468,28 @@ class HierarchyCheck {
         auto superInterfaceDecl =
             std::dynamic_pointer_cast<parsetree::ast::InterfaceDecl>(
                 superInterface->getResolvedDecl().getAstNode());
-        if (superInterfaceDecl &&
-            !getInheritedMethods(superInterfaceDecl, abstractMethodMap,
-                                 methodMap, implements))
-          return false;
+        if (superInterfaceDecl && success)
+          success = inheritMethods(table, getMemberTable(superInterfaceDecl));
       }
       // Resolve current interface's abstract methods
       for (auto &method : interfaceDecl->getMethods()) {
+        if (!success)
+          break;
         if (!method)
           continue;
-        std::string signature = method->getSignature();
-        // Some inherited functions have same signature but different return
-        // types
-        if (abstractMethodMap.count(signature) &&
-            getSafeReturnType(abstractMethodMap[signature]) !=
-                getSafeReturnType(method))
-          return false;
-        if (methodMap.count(signature) &&
-            getSafeReturnType(methodMap[signature]) !=
-                getSafeReturnType(method))
-          return false;
-        // If same signature and return, don't insert; otherwise not present, so
-        // insert
-        if (!abstractMethodMap.count(signature)) {
-          abstractMethodMap[signature] = method;
-        }
-        // New abstract declaration means that it needs to be implemented by
-        // child node
-        implements.erase(signature);
+        success = declareMethod(table, method, true);
       }
     }
-    return true;
-  }
-
-  void getInheritedFields(
-      std::shared_ptr<parsetree::ast::Decl> astNode,
-      std::unordered_map<std::string,
-                         std::shared_ptr<parsetree::ast::FieldDecl>> &fieldMap,
-      bool isCurrentClass) {
-    auto classDecl =
-        std::dynamic_pointer_cast<parsetree::ast::ClassDecl>(astNode);
-    // An interface cannot have fields
-    if (!classDecl)
-      return;
-    for (auto &superClass : sanitizedSuperClasses(classDecl)) {
-      getInheritedFields(superClass, fieldMap, false);
-    }
-    if (isCurrentClass) {
-      return;
-    }
-    for (auto &field : classDecl->getFields()) {
-      if (!field)
-        continue;
-      if (!fieldMap.contains(field->getName()))
-        fieldMap[field->getName()] = field;
-    }
+    table.methods.success = success;
+    return table;
   }
 
   bool checkInheritence(std::shared_ptr<Decl> decl) {
     std::shared_ptr<parsetree::ast::Decl> astNode = decl->getAstNode();
-    std::unordered_map<std::string, std::shared_ptr<parsetree::ast::MethodDecl>>
-        abstractMethodMap;
-    std::unordered_map<std::string, std::shared_ptr<parsetree::ast::MethodDecl>>
-        methodMap;
-    std::unordered_set<std::string> implements;
+    const auto &table = getMemberTable(astNode);
     // Type conflict of same signature, different return type methods in
     // superclasses
-    if (!getInheritedMethods(astNode, abstractMethodMap, methodMap,
-                             implements)) {
+    if (!table.methods.success) {
       return false;
     }
 
@@ -463,8 +509,8 @@ class HierarchyCheck {
           return false;
         }
       }
-      for (auto &[signature, methodDecl] : abstractMethodMap) {
-        if (!implements.count(signature)) {
+      for (auto &[signature, methodDecl] : table.methods.abstractMethods) {
+        if (!table.implements.count(signature)) {
           std::cerr << "Error: Class " << classDecl->getName()
                     << " inherits an unimplemented abstract method but is not "
                        "declared abstract.\n";
@@ -481,7 +527,7 @@ class HierarchyCheck {
     if (auto classDecl =
             std::dynamic_pointer_cast<parsetree::ast::ClassDecl>(astNode)) {
       for (auto &method : classDecl->getMethods()) {
-        std::string signature = method->getSignature();
+        parsetree::Symbol signature = method->getSignatureSymbol();
         bool isMethodStatic =
             method->getModifiers() && method->getModifiers()->isStatic();
 
@@ -499,7 +545,7 @@ class HierarchyCheck {
             for (auto &superMethod : superClassDecl->getMethods()) {
               // std::cout << superMethod->getSignature() << " " << signature
               //           << std::endl;
-              if (superMethod->getSignature() == signature) {
+              if (superMethod->getSignatureSymbol() == signature) {
                 bool isSuperMethodStatic =
                     superMethod->getModifiers() &&
                     superMethod->getModifiers()->isStatic();
@@ -519,7 +565,7 @@ class HierarchyCheck {
                    std::dynamic_pointer_cast<parsetree::ast::InterfaceDecl>(
                        astNode)) {
       for (auto &method : interfaceDecl->getMethods()) {
-        std::string signature = method->getSignature();
+        parsetree::Symbol signature = method->getSignatureSymbol();
         bool isMethodStatic =
             method->getModifiers() && method->getModifiers()->isStatic();
 
@@ -534,7 +580,7 @@ class HierarchyCheck {
               continue;
 
             for (auto &superMethod : superInterfaceDecl->getMethods()) {
-              if (superMethod->getSignature() == signature) {
+              if (superMethod->getSignatureSymbol() == signature) {
                 bool isSuperMethodStatic =
                     superMethod->getModifiers() &&
                     superMethod->getModifiers()->isStatic();
@@ -563,7 +609,7 @@ class HierarchyCheck {
     if (auto classDecl =
             std::dynamic_pointer_cast<parsetree::ast::ClassDecl>(astNode)) {
       for (auto &method : classDecl->getMethods()) {
-        std::string signature = method->getSignature();
+        parsetree::Symbol signature = method->getSignatureSymbol();
         bool isMethodStatic =
             method->getModifiers() && method->getModifiers()->isStatic();
 
@@ -577,7 +623,7 @@ class HierarchyCheck {
               continue;
 
             for (auto &superMethod : superClassDecl->getMethods()) {
-              if (superMethod->getSignature() == signature) {
+              if (superMethod->getSignatureSymbol() == signature) {
                 bool isSuperMethodStatic =
                     superMethod->getModifiers() &&
                     superMethod->getModifiers()->isStatic();
@@ -598,7 +644,7 @@ class HierarchyCheck {
                    std::dynamic_pointer_cast<parsetree::ast::InterfaceDecl>(
                        astNode)) {
       for (auto &method : interfaceDecl->getMethods()) {
-        std::string signature = method->getSignature();
+        parsetree::Symbol signature = method->getSignatureSymbol();
         bool isMethodStatic =
             method->getModifiers() && method->getModifiers()->isStatic();
 
@@ -613,7 +659,7 @@ class HierarchyCheck {
               continue;
 
             for (auto &superMethod : superInterfaceDecl->getMethods()) {
-              if (superMethod->getSignature() == signature) {
+              if (superMethod->getSignatureSymbol() == signature) {
                 bool isSuperMethodStatic =
                     superMethod->getModifiers() &&
                     superMethod->getModifiers()->isStatic();
@@ -643,7 +689,7 @@ class HierarchyCheck {
     if (auto classDecl =
             std::dynamic_pointer_cast<parsetree::ast::ClassDecl>(astNode)) {
       for (auto &method : classDecl->getMethods()) {
-        std::string signature = method->getSignature();
+        parsetree::Symbol signature = method->getSignatureSymbol();
         std::string returnType =
             method->getReturnType() ? method->getReturnType()->toString() : "";
         for (auto &superClass : classDecl->getSuperClasses()) {
@@ -658,7 +704,7 @@ class HierarchyCheck {
             for (auto &superMethod : superClassDecl->getMethods()) {
               if (!superMethod)
                 continue;
-              if (superMethod->getSignature() == signature) {
+              if (superMethod->getSignatureSymbol() == signature) {
                 std::string superReturnType =
                     superMethod->getReturnType()
                         ? superMethod->getReturnType()->toString()
@@ -680,17 +726,16 @@ class HierarchyCheck {
                    std::dynamic_pointer_cast<parsetree::ast::InterfaceDecl>(
                        astNode)) {
 
-      std::vector<std::shared_ptr<parsetree::ast::ReferenceType>>
-          superInterfaces = interfaceDecl->getInterfaces();
+      const auto &superInterfaces = interfaceDecl->getInterfaces();
+      auto objectDecl = resolveJavaLangObjectInterfaces(rootPackage);
 
       for (auto &method : interfaceDecl->getMethods()) {
-        std::string signature = method->getSignature();
-        auto objectDecl = resolveJavaLangObjectInterfaces(rootPackage);
+        parsetree::Symbol signature = method->getSignatureSymbol();
         if (objectDecl) {
           for (auto &objectMethod : objectDecl->getMethods()) {
             if (!objectMethod)
               continue;
-            if (objectMethod->getSignature() == signature) {
+            if (objectMethod->getSignatureSymbol() == signature) {
               bool isReturnTypeDiff =
                   getSafeReturnType(objectMethod) != getSafeReturnType(method);
               if (isReturnTypeDiff) {
@@ -721,7 +766,7 @@ class HierarchyCheck {
             for (auto &superMethod : superInterfaceDecl->getMethods()) {
               if (!superMethod)
                 continue;
-              if (superMethod->getSignature() == signature) {
+              if (superMethod->getSignatureSymbol() == signature) {
                 bool isSuperMethodFinal =
                     superMethod->getModifiers() &&
                     superMethod->getModifiers()->isFinal();
@@ -750,7 +795,7 @@ class HierarchyCheck {
 
     if (auto classDecl =
             std::dynamic_pointer_cast<parsetree::ast::ClassDecl>(astNode)) {
-      auto inheritedMethods = getAllInheritedMethods(classDecl);
+      const auto &inheritedMethods = getAllInheritedMethods(classDecl);
 
       for (auto &[signature, method] : inheritedMethods.methods) {
         bool isMethodProtected =
@@ -770,7 +815,7 @@ class HierarchyCheck {
               continue;
 
             for (auto &superMethod : superInterfaceDecl->getMethods()) {
-              if (superMethod->getSignature() == signature) {
+              if (superMethod->getSignatureSymbol() == signature) {
                 bool isSuperMethodPublic =
                     superMethod->getModifiers() &&
                     superMethod->getModifiers()->isPublic();
@@ -812,11 +857,10 @@ class HierarchyCheck {
 
     if (auto classDecl =
             std::dynamic_pointer_cast<parsetree::ast::ClassDecl>(astNode)) {
-      std::vector<std::shared_ptr<parsetree::ast::ReferenceType>> superClasses =
-          classDecl->getSuperClasses();
+      const auto &superClasses = classDecl->getSuperClasses();
 
       for (auto &method : classDecl->getMethods()) {
-        std::string signature = method->getSignature();
+        parsetree::Symbol signature = method->getSignatureSymbol();
 
         for (auto &superClass : superClasses) {
           if (!superClass || !superClass->getResolvedDecl().getAstNode())
@@ -831,7 +875,7 @@ class HierarchyCheck {
               if (!superMethod)
                 continue;
 
-              if (superMethod->getSignature() == signature) {
+              if (superMethod->getSignatureSymbol() == signature) {
 
                 bool isSuperMethodFinal =
                     superMethod->getModifiers() &&
@@ -851,18 +895,17 @@ class HierarchyCheck {
     } else if (auto interfaceDecl =
                    std::dynamic_pointer_cast<parsetree::ast::InterfaceDecl>(
                        astNode)) {
-      std::vector<std::shared_ptr<parsetree::ast::ReferenceType>>
-          superInterfaces = interfaceDecl->getInterfaces();
+      const auto &superInterfaces = interfaceDecl->getInterfaces();
+      auto objectDecl = resolveJavaLangObjectInterfaces(rootPackage);
 
       for (auto &method : interfaceDecl->getMethods()) {
-        std::string signature = method->getSignature();
+        parsetree::Symbol signature = method->getSignatureSymbol();
 
-        auto objectDecl = resolveJavaLangObjectInterfaces(rootPackage);
         if (objectDecl) {
           for (auto &objectMethod : objectDecl->getMethods()) {
             if (!objectMethod)
               continue;
-            if (objectMethod->getSignature() == signature) {
+            if (objectMethod->getSignatureSymbol() == signature) {
               bool isObjectMethodFinal =
                   objectMethod->getModifiers() &&
                   objectMethod->getModifiers()->isFinal();
@@ -895,7 +938,7 @@ class HierarchyCheck {
               if (!superMethod)
                 continue;
 
-              if (superMethod->getSignature() == signature) {
+              if (superMethod->getSignatureSymbol() == signature) {
                 bool isSuperMethodFinal =
                     superMethod->getModifiers() &&
                     superMethod->getModifiers()->isFinal();
@@ -974,29 +1017,18 @@ public:
     return traverseTree(rootPackage);
   }
 
-  // Wrapper
-  std::unordered_map<std::string, std::shared_ptr<parsetree::ast::FieldDecl>>
+  // Fields inherited from the superclasses, without the declared ones
+  const FieldMap &
   getInheritedFields(std::shared_ptr<parsetree::ast::Decl> astNode) {
-    std::unordered_map<std::string, std::shared_ptr<parsetree::ast::FieldDecl>>
-        fields;
-    getInheritedFields(astNode, fields, true);
-    return fields;
+    return getMemberTable(astNode).inheritedFields;
   }
 
-  InheritedMethodsResult
+  const InheritedMethodsResult &
   getAllInheritedMethods(std::shared_ptr<parsetree::ast::Decl> astNode) {
-    InheritedMethodsResult result;
-
-    if (!astNode) {
-      result.success = false;
-      return result;
-    }
-
-    std::unordered_set<std::string> implements;
-    bool success = getInheritedMethods(astNode, result.abstractMethods,
-                                       result.methods, implements);
-    result.success = success;
-    return result;
+    static const InheritedMethodsResult failed;
+    if (!astNode)
+      return failed;
+    return getMemberTable(astNode).methods;
   }
 };
 
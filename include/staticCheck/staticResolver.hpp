@@ -10,10 +10,10 @@ struct StaticResolverState {
   bool isStaticContext;
   bool isInstFieldInitializer;
   std::shared_ptr<parsetree::ast::ClassDecl> currentClass;
-  std::shared_ptr<parsetree::ast::ScopeID> fieldScope;
+  parsetree::ast::ScopeID fieldScope;
   StaticResolverState()
       : isStaticContext{false}, isInstFieldInitializer{false},
-        currentClass{nullptr}, fieldScope{nullptr} {}
+        currentClass{nullptr}, fieldScope{} {}
 };
 
 // store info in static resolution
@@ -52,6 +52,10 @@ struct StaticResolverData {
 class StaticResolver : public Evaluator<StaticResolverData> {
 
 public:
+  explicit StaticResolver(
+      std::shared_ptr<parsetree::ast::ASTManager> astManager)
+      : astManager(astManager) {}
+
   void evaluate(std::shared_ptr<parsetree::ast::Expr> expr,
                 StaticResolverState state);
 
@@ -106,6 +110,7 @@ private:
   void isAccessible(StaticResolverData lhs, StaticResolverData var) const;
 
 private:
+  std::shared_ptr<parsetree::ast::ASTManager> astManager;
   StaticResolverState state;
 };
 
@@ -4,6 +4,9 @@
 #include "envManager.hpp"
 #include "environment.hpp"
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace static_check {
 
@@ -29,14 +32,15 @@ public:
   }
 
   ////////////////////// Resolvers ////////////////////
-  // Second pass
-  void resolve();
+  // Second pass. Units are linked independently once the symbol table is
+  // built, on up to numJobs threads; the first error in AST order is thrown.
+  void resolve(unsigned numJobs = 1);
 
   Package::packageChild
   resolveImport(std::shared_ptr<parsetree::ast::UnresolvedType> node);
 
   Package::packageChild
-  resolveImport(const std::vector<std::string> &identifiers);
+  resolveImport(const std::vector<parsetree::Symbol> &identifiers);
 
   void
   resolveType(std::shared_ptr<parsetree::ast::Type> type,
@@ -47,17 +51,35 @@ public:
       std::shared_ptr<parsetree::ast::ProgramDecl> program = nullptr);
 
   Package::packageChild resolveSimpleName(
-      const std::string &simpleName,
+      parsetree::Symbol simpleName,
       std::shared_ptr<parsetree::ast::ProgramDecl> program = nullptr);
 
-  Package::packageChild resolveClassName(const std::string &simpleName);
+  Package::packageChild resolveClassName(parsetree::Symbol simpleName);
 
   Package::packageChild resolveQualifiedName(
-      const std::vector<std::string> &identifiers,
+      const std::vector<parsetree::Symbol> &identifiers,
       std::shared_ptr<parsetree::ast::ProgramDecl> program = nullptr);
 
-  std::unordered_map<std::string, Package::packageChild> &
-  getContext(std::shared_ptr<parsetree::ast::ProgramDecl> node) {
+private:
+  // What simple names mean inside one compilation unit. initContext checks
+  // the imports and keeps what each shadowing step needs, a name is only
+  // looked up the first time it is used and then remembered, including
+  // names that resolve to nothing or to an ambiguous on-demand import.
+  struct Context {
+    std::shared_ptr<Decl> body;
+    std::unordered_map<parsetree::Symbol, std::shared_ptr<Decl>>
+        singleTypeImports;
+    std::shared_ptr<Package> package;
+    std::vector<std::shared_ptr<Package>> onDemandImports;
+
+    struct Entry {
+      Package::packageChild child;
+      bool ambiguous = false;
+    };
+    std::unordered_map<parsetree::Symbol, Entry> names;
+  };
+
+  Context &getContext(std::shared_ptr<parsetree::ast::ProgramDecl> node) {
     auto it = contextMap.find(node);
     if (it == contextMap.end()) {
       throw std::runtime_error("Could not find context for node");
@@ -65,19 +87,49 @@ public:
     return it->second;
   }
 
-private:
+  Context::Entry lookupName(const Context &context,
+                            parsetree::Symbol simpleName) const;
+
   // First pass?
   void buildSymbolTable();
-  // Second pass recursive helper
-  void resolveAST(std::shared_ptr<parsetree::ast::AstNode> ast);
+  // Second pass recursive helper, collects the class and interface decls
+  // of the unit into decls
+  void resolveAST(std::shared_ptr<parsetree::ast::AstNode> ast,
+                  std::shared_ptr<parsetree::ast::ProgramDecl> program,
+                  std::vector<std::shared_ptr<parsetree::ast::Decl>> &decls);
+
+  // The rest of a qualified name once its first identifier resolved to
+  // first, nullptr if there is no such package or type
+  Package::packageChild
+  resolveRest(const Package::packageChild &first,
+              const std::vector<parsetree::Symbol> &identifiers) const;
+
+  struct QualifiedNameHash {
+    size_t operator()(const std::vector<parsetree::Symbol> &identifiers) const {
+      size_t hash = 0;
+      for (const auto &id : identifiers)
+        hash = hash * 31 + id.hash();
+      return hash;
+    }
+  };
 
   std::shared_ptr<parsetree::ast::ASTManager> astManager;
   std::shared_ptr<EnvManager> envManager;
   std::shared_ptr<Package> rootPackage; // no decl
-  std::unordered_map<std::shared_ptr<parsetree::ast::ProgramDecl>,
-                     std::unordered_map<std::string, Package::packageChild>>
+  // Every package and type in the trie by its fully qualified name, and
+  // every type by its simple name. Filled in by buildSymbolTable, so a
+  // lookup is one probe however deep the package is.
+  std::unordered_map<std::vector<parsetree::Symbol>, Package::packageChild,
+                     QualifiedNameHash>
+      qualifiedIndex;
+  std::unordered_map<parsetree::Symbol, std::vector<std::shared_ptr<Decl>>>
+      simpleNameIndex;
+  // One entry per AST is added before linking starts, so units linked in
+  // parallel only ever touch their own context
+  std::unordered_map<std::shared_ptr<parsetree::ast::ProgramDecl>, Context>
       contextMap;
-  std::shared_ptr<parsetree::ast::ProgramDecl> currentProgram; // for each AST
+  // Default for the resolvers called after linking (ExprResolver)
+  std::shared_ptr<parsetree::ast::ProgramDecl> currentProgram;
 
   static const std::string DEFAULT_PACKAGE_NAME;
 };
@@ -37,6 +37,9 @@ public:
   bool isSuperClass(std::shared_ptr<parsetree::ast::AstNode> super,
                     std::shared_ptr<parsetree::ast::AstNode> child) const;
 
+  bool isSuperInterface(std::shared_ptr<parsetree::ast::AstNode> interface,
+                        std::shared_ptr<parsetree::ast::AstNode> child) const;
+
   void resolve();
 
 private:
@@ -88,6 +91,12 @@ private:
 
   bool isTypeString(std::shared_ptr<parsetree::ast::Type> type) const;
 
+  // The canonical one, see TypeTable
+  std::shared_ptr<parsetree::ast::BasicType>
+  basicType(parsetree::ast::BasicType::Type type) const {
+    return astManager->types.getBasicType(type);
+  }
+
   void resolveAST(const std::shared_ptr<parsetree::ast::AstNode> &node);
 
   std::shared_ptr<parsetree::ast::Type>
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace utils {
+
+// Per-phase wall time, CPU time, peak RSS and allocation counts for
+// --time-report. Phases are timed with a Scope; when no report is active a
+// Scope does nothing, so they can stay in the compiler permanently.
+class TimeReport {
+public:
+  enum class Format { Table, Json };
+
+  struct Entry {
+    std::string phase;
+    std::string unit; // compilation unit, empty for a whole phase
+    double wallMs;
+    double cpuMs;
+    long peakRssKb; // high-water mark of the process when the phase ended
+    uint64_t allocations;
+  };
+
+  // While alive this is the active report. Printed to stderr when it goes
+  // away, so early returns out of main still get a report.
+  explicit TimeReport(Format format);
+  ~TimeReport();
+
+  TimeReport(const TimeReport &) = delete;
+  TimeReport &operator=(const TimeReport &) = delete;
+
+  static TimeReport *active() { return current; }
+
+  void add(Entry entry);
+  void print(std::ostream &os) const;
+  void printJson(std::ostream &os) const;
+
+  // Times from construction until stop() or destruction. With a unit it
+  // measures only the calling thread (CPU and allocations), so per-file
+  // entries stay meaningful under -j.
+  class Scope {
+  public:
+    explicit Scope(std::string phase, std::string unit = "");
+    ~Scope() { stop(); }
+
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+    void stop();
+
+  private:
+    TimeReport *report;
+    std::string phase;
+    std::string unit;
+    int64_t wallStart;
+    int64_t cpuStart;
+    uint64_t allocStart;
+  };
+
+  // Number of operator new calls so far, by the whole process or by the
+  // calling thread. Only counted while a report is active.
+  static uint64_t allocationCount();
+  static uint64_t threadAllocationCount();
+
+private:
+  static inline TimeReport *current = nullptr;
+
+  Format format;
+  mutable std::mutex mutex; // units finish on worker threads
+  std::vector<Entry> entries;
+};
+
+} // namespace utils
@@ -0,0 +1,65 @@
+#!/usr/bin/bash
+
+# Per-phase allocation counts of joosc compiling a program with the whole
+# stdlib, before and after a commit. Both revisions are built in temporary
+# worktrees and run with --time-report=json.
+#
+# Usage: alloc-benchmark.sh [commit] [input.java]
+#   commit  compared against its parent (default: HEAD)
+#   STDLIB  stdlib compiled along with the program
+
+ROOT_DIR="$(cd "$(dirname "$0")/.." && pwd)"
+COMMIT="${1:-HEAD}"
+INPUT="$(realpath "${2:-$ROOT_DIR/tests/input/J1_1_AmbiguousName_AccessResultFromMethod.java}")"
+STDLIB="${STDLIB:-/u/cs444/pub/stdlib/6.1}"
+
+mapfile -t stdlib_files < <(find "$STDLIB" -type f -name "*.java" | sort)
+if [ ${#stdlib_files[@]} -eq 0 ]; then
+    echo "No stdlib found at $STDLIB, set STDLIB"
+    exit 1
+fi
+
+WORK_DIR="$(mktemp -d)"
+cleanup() {
+    git -C "$ROOT_DIR" worktree remove --force "$WORK_DIR/before" 2>/dev/null
+    git -C "$ROOT_DIR" worktree remove --force "$WORK_DIR/after" 2>/dev/null
+    rm -rf "$WORK_DIR"
+}
+trap cleanup EXIT
+
+# Builds joosc at a revision and writes its time report to $WORK_DIR/$1.json
+run() {
+    local name=$1 rev=$2
+    local tree="$WORK_DIR/$name"
+    git -C "$ROOT_DIR" worktree add --detach "$tree" "$rev" > /dev/null || return 1
+    cmake -S "$tree" -B "$tree/build" -DCMAKE_BUILD_TYPE=Release > /dev/null &&
+        cmake --build "$tree/build" --target joosc -j"$(nproc)" > /dev/null ||
+        return 1
+    mkdir -p "$WORK_DIR/run-$name"
+    (cd "$WORK_DIR/run-$name" &&
+     "$tree/build/joosc" --time-report=json "$INPUT" "${stdlib_files[@]}" \
+         > /dev/null 2> "$WORK_DIR/$name.err")
+    # The report is the last thing on stderr
+    sed -n '/^{"phases": \[/,$p' "$WORK_DIR/$name.err" > "$WORK_DIR/$name.json"
+    [ -s "$WORK_DIR/$name.json" ]
+}
+
+run before "$COMMIT^" || { echo "Failed to build or run $COMMIT^"; exit 1; }
+run after "$COMMIT" || { echo "Failed to build or run $COMMIT"; exit 1; }
+
+python3 - "$WORK_DIR/before.json" "$WORK_DIR/after.json" <<'EOF'
+import json, sys
+
+def phases(path):
+    with open(path) as f:
+        entries = json.load(f)["phases"]
+    return {e["phase"]: e["allocations"] for e in entries if "unit" not in e}
+
+before, after = phases(sys.argv[1]), phases(sys.argv[2])
+print(f"{'phase':28}{'before':>14}{'after':>14}{'change':>10}")
+for phase in list(before) + [p for p in after if p not in before]:
+    b, a = before.get(phase), after.get(phase)
+    change = f"{(a - b) / b * 100:+.1f}%" if a is not None and b else ""
+    print(f"{phase:28}{b if b is not None else '-':>14}"
+          f"{a if a is not None else '-':>14}{change:>10}")
+EOF
@@ -0,0 +1,84 @@
+#!/usr/bin/bash
+
+# Round trip test for --emit-checked-ast/--use-checked-ast. Each program is
+# compiled once from source while saving its checked AST, then again from the
+# saved AST, and the assembly of the two runs has to be identical.
+#
+# Usage: run-checked-ast-test.sh [input.java...]
+#   JOOSC   compiler to test (default: build/joosc)
+#   STDLIB  stdlib compiled along with every program
+
+ROOT_DIR="$(cd "$(dirname "$0")/.." && pwd)"
+JOOSC="${JOOSC:-$ROOT_DIR/build/joosc}"
+STDLIB="${STDLIB:-/u/cs444/pub/stdlib/6.1}"
+
+if [ ! -x "$JOOSC" ]; then
+    echo "joosc not found at $JOOSC, build it or set JOOSC"
+    exit 1
+fi
+
+if [ $# -gt 0 ]; then
+    inputs=("$@")
+else
+    inputs=(
+        "$ROOT_DIR/tests/input/J1_1_AmbiguousName_AccessResultFromMethod.java"
+        "$ROOT_DIR/tests/input/features_methodoverloading.java"
+        "$ROOT_DIR/tests/input/features_interfaces.java"
+        "$ROOT_DIR/tests/input/features_extends.java"
+        "$ROOT_DIR/tests/input/features_for.java"
+    )
+fi
+
+mapfile -t stdlib_files < <(find "$STDLIB" -type f -name "*.java" | sort)
+
+# joosc writes to ./output, so every run gets its own directory
+WORK_DIR="$(mktemp -d)"
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+NUM_PASSED=0
+NUM_FAILED=0
+NUM_SKIPPED=0
+
+for input in "${inputs[@]}"; do
+    name=$(basename "$input" .java)
+    files=("$input" "${stdlib_files[@]}")
+    ast="$WORK_DIR/$name.ast"
+
+    mkdir -p "$WORK_DIR/source" "$WORK_DIR/checked"
+
+    # Not every input is a whole program with an entry point, those can't
+    # produce assembly to compare
+    if ! (cd "$WORK_DIR/source" &&
+          "$JOOSC" --emit-checked-ast="$ast" "${files[@]}" > /dev/null 2>&1); then
+        echo "SKIP - $name does not compile from source"
+        NUM_SKIPPED=$((NUM_SKIPPED+1))
+        continue
+    fi
+
+    if ! (cd "$WORK_DIR/checked" &&
+          "$JOOSC" --use-checked-ast="$ast" "${files[@]}" > /dev/null 2>&1); then
+        echo "FAIL - $name does not compile from its checked AST"
+        NUM_FAILED=$((NUM_FAILED+1))
+        continue
+    fi
+
+    if ! ls "$WORK_DIR/source/output"/*.s > /dev/null 2>&1; then
+        echo "SKIP - $name generates no assembly"
+        NUM_SKIPPED=$((NUM_SKIPPED+1))
+        continue
+    fi
+
+    if diff -r "$WORK_DIR/source/output" "$WORK_DIR/checked/output" > /dev/null; then
+        echo "PASS - $name"
+        NUM_PASSED=$((NUM_PASSED+1))
+    else
+        echo "FAIL - $name generates different assembly from its checked AST"
+        diff -r "$WORK_DIR/source/output" "$WORK_DIR/checked/output" | head -20
+        NUM_FAILED=$((NUM_FAILED+1))
+    fi
+done
+
+echo "Passed: $NUM_PASSED, failed: $NUM_FAILED, skipped: $NUM_SKIPPED"
+if [ $NUM_FAILED -ne 0 ] || [ $NUM_PASSED -eq 0 ]; then
+    exit 1
+fi
@@ -17,7 +17,7 @@ void Decl::setParent(std::shared_ptr<CodeBody> rawParent) {
 ProgramDecl::ProgramDecl(std::shared_ptr<ReferenceType> package,
                          std::vector<std::shared_ptr<ImportDecl>> imports,
                          std::shared_ptr<CodeBody> body)
-    : package{package}, imports{imports}, body{body} {
+    : package{package}, imports{std::move(imports)}, body{body} {
   std::unordered_map<std::string, std::string> existingImports;
 
   auto decl = std::dynamic_pointer_cast<Decl>(body);
@@ -27,7 +27,7 @@ ProgramDecl::ProgramDecl(std::shared_ptr<ReferenceType> package,
     throw std::runtime_error("Body must be a Decl.");
   }
 
-  for (const auto &importDecl : imports) {
+  for (const auto &importDecl : this->imports) {
     if (importDecl->hasStar()) {
       continue;
     }
@@ -39,7 +39,8 @@ ProgramDecl::ProgramDecl(std::shared_ptr<ReferenceType> package,
           "Import Decl is not an Unresolved Type in the AST construction");
     }
     std::string qualifiedName = qualifiedIdentifier->toString();
-    std::string importedType = qualifiedIdentifier->getIdentifiers().back();
+    const std::string &importedType =
+        qualifiedIdentifier->getIdentifiers().back().str();
 
     // Ensure no conflicting single-type-import declarations
     if (existingImports.find(importedType) != existingImports.end() &&
@@ -52,13 +53,14 @@ ProgramDecl::ProgramDecl(std::shared_ptr<ReferenceType> package,
   }
 }
 
-ClassDecl::ClassDecl(std::shared_ptr<Modifiers> modifiers, std::string name,
+ClassDecl::ClassDecl(std::shared_ptr<Modifiers> modifiers, Symbol name,
                      std::shared_ptr<ReferenceType> superClass,
                      std::shared_ptr<ReferenceType> objectType,
                      std::vector<std::shared_ptr<ReferenceType>> interfaces,
                      std::vector<std::shared_ptr<Decl>> classBodyDecls)
     : Decl{name}, modifiers{modifiers}, superClasses{superClass, objectType},
-      interfaces{interfaces}, classBodyDecls{classBodyDecls} {
+      interfaces{std::move(interfaces)},
+      classBodyDecls{std::move(classBodyDecls)} {
   // Check for valid modifiers.
   if (!modifiers) {
     throw std::runtime_error("Class Decl Invalid modifiers.");
@@ -73,7 +75,7 @@ ClassDecl::ClassDecl(std::shared_ptr<Modifiers> modifiers, std::string name,
   bool foundConstructor = false;
   std::unordered_set<std::string> fieldNames;
 
-  for (const auto &decl : classBodyDecls) {
+  for (const auto &decl : this->classBodyDecls) {
     auto field = std::dynamic_pointer_cast<FieldDecl>(decl);
     if (field) {
       const auto &fieldName = field->getName();
@@ -89,7 +91,7 @@ ClassDecl::ClassDecl(std::shared_ptr<Modifiers> modifiers, std::string name,
     }
     if (field == nullptr && method == nullptr) {
       throw std::runtime_error("Class Decl Invalid declarations for class " +
-                               name);
+                               name.str());
     }
   }
   if (!foundConstructor) {
@@ -97,23 +99,25 @@ ClassDecl::ClassDecl(std::shared_ptr<Modifiers> modifiers, std::string name,
         "Every class must contain at least one explicit constructor");
   }
 
-  for (const auto &decl : classBodyDecls) {
+  for (const auto &decl : this->classBodyDecls) {
     auto method = std::dynamic_pointer_cast<MethodDecl>(decl);
     if (!method || !(method->isConstructor()))
       continue;
-    if (name != method->getName()) {
+    if (name != method->getSymbol()) {
       throw std::runtime_error("Constructor name must match class name.");
     }
   }
 
   std::unordered_set<std::string> interfaceNames;
-  for (const auto &interface : interfaces) {
+  for (const auto &interface : this->interfaces) {
     const auto &interfaceName = interface->toString();
     if (!interfaceNames.insert(interfaceName).second) {
       throw std::runtime_error("Interface \"" + interfaceName +
                                "\" is already implemented.");
     }
   }
+
+  indexMembers();
 }
 
 void ClassDecl::setParent(std::shared_ptr<CodeBody> parent) {
@@ -133,40 +137,49 @@ void ClassDecl::setParent(std::shared_ptr<CodeBody> parent) {
     method->setParent(std::static_pointer_cast<CodeBody>(shared_from_this()));
 }
 
-std::vector<std::shared_ptr<MethodDecl>> ClassDecl::getConstructors() const {
-  std::vector<std::shared_ptr<MethodDecl>> constructors;
+void ClassDecl::indexMembers() {
+  fields.clear();
+  methods.clear();
+  constructors.clear();
+  fieldIndex.clear();
+  methodIndex.clear();
 
   for (const auto &decl : classBodyDecls) {
-    if (auto methodDecl = std::dynamic_pointer_cast<MethodDecl>(decl)) {
-      if (methodDecl->isConstructor()) {
+    if (auto fieldDecl = std::dynamic_pointer_cast<FieldDecl>(decl)) {
+      fieldIndex.emplace(fieldDecl->getSymbol(), fields.size());
+      fields.push_back(fieldDecl);
+    } else if (auto methodDecl = std::dynamic_pointer_cast<MethodDecl>(decl)) {
+      // overloads keep the first one, like the old linear search
+      methodIndex.emplace(methodDecl->getSymbol(), methodDecl);
+      methods.push_back(methodDecl);
+      if (methodDecl->isConstructor())
         constructors.push_back(methodDecl);
-      }
     }
   }
-  return constructors;
 }
 
 InterfaceDecl::InterfaceDecl(
-    std::shared_ptr<Modifiers> modifiers, std::string name,
+    std::shared_ptr<Modifiers> modifiers, Symbol name,
     std::vector<std::shared_ptr<ReferenceType>> interfaces,
     std::shared_ptr<ReferenceType> objectType,
     std::vector<std::shared_ptr<Decl>> interfaceBody)
-    : Decl{name}, modifiers{modifiers}, interfaces{interfaces},
-      objectType{objectType}, interfaceBodyDecls{interfaceBody} {
+    : Decl{name}, modifiers{modifiers}, interfaces{std::move(interfaces)},
+      objectType{objectType}, interfaceBodyDecls{std::move(interfaceBody)} {
   if (!modifiers) {
     throw std::runtime_error("Interface Decl Invalid modifiers for interface " +
-                             name);
+                             name.str());
   }
   if (modifiers->isFinal()) {
     throw std::runtime_error("An interface cannot be final for interface " +
-                             name);
+                             name.str());
   }
   if (!modifiers->isPublic()) {
     throw std::runtime_error(
-        "Interface must have a visibility modifier for interface " + name);
+        "Interface must have a visibility modifier for interface " +
+        name.str());
   }
   // Check declarations
-  for (const auto &decl : interfaceBody) {
+  for (const auto &decl : interfaceBodyDecls) {
     auto field = std::dynamic_pointer_cast<FieldDecl>(decl);
     if (field) {
       throw std::runtime_error("An interface cannot contain fields.");
@@ -192,11 +205,26 @@ InterfaceDecl::InterfaceDecl(
         }
         if (!methodModifiers->isAbstract()) {
           throw std::runtime_error(
-              "An interface method must be abstract for interface " + name);
+              "An interface method must be abstract for interface " +
+              name.str());
         }
       }
     }
   }
+
+  indexMembers();
+}
+
+void InterfaceDecl::indexMembers() {
+  methods.clear();
+  methodIndex.clear();
+
+  for (const auto &decl : interfaceBodyDecls) {
+    if (auto methodDecl = std::dynamic_pointer_cast<MethodDecl>(decl)) {
+      methodIndex.emplace(methodDecl->getSymbol(), methodDecl);
+      methods.push_back(methodDecl);
+    }
+  }
 }
 
 void InterfaceDecl::setParent(std::shared_ptr<CodeBody> parent) {
@@ -214,17 +242,18 @@ void InterfaceDecl::setParent(std::shared_ptr<CodeBody> parent) {
     method->setParent(std::static_pointer_cast<CodeBody>(shared_from_this()));
 }
 
-MethodDecl::MethodDecl(std::shared_ptr<Modifiers> modifiers, std::string name,
+MethodDecl::MethodDecl(std::shared_ptr<Modifiers> modifiers, Symbol name,
                        std::shared_ptr<Type> returnType,
                        std::vector<std::shared_ptr<VarDecl>> params,
                        bool isConstructor, std::shared_ptr<Block> methodBody,
                        const source::SourceRange loc)
     : Decl{name, loc}, modifiers{modifiers}, returnType{returnType},
-      params{params}, isConstructor_{isConstructor}, methodBody{methodBody} {
+      params{std::move(params)}, isConstructor_{isConstructor},
+      methodBody{methodBody} {
   // Check for valid modifiers
   if (!modifiers || modifiers->isInvalid()) {
     throw std::runtime_error("Method Decl Invalid modifiers for method " +
-                             name);
+                             name.str());
   }
   // Restrictions for constructors
   if (isConstructor) {
@@ -245,65 +274,66 @@ MethodDecl::MethodDecl(std::shared_ptr<Modifiers> modifiers, std::string name,
     // A method has a body iff it is neither abstract nor native
     if ((modifiers->isAbstract() || modifiers->isNative()) && methodBody) {
       throw std::runtime_error(
-          "An abstract or native method cannot have a body for method " + name);
+          "An abstract or native method cannot have a body for method " +
+          name.str());
     }
     if (!modifiers->isAbstract() && !modifiers->isNative() && !methodBody) {
       throw std::runtime_error(
           "A non-abstract and non-native method must have a body for method " +
-          name);
+          name.str());
     }
   }
   // Other restrictions for modifiers. These apply to constructors and methods.
   if (modifiers->isPublic() && modifiers->isProtected()) {
     throw std::runtime_error("A method or constructor cannot be both public "
                              "and protected for method " +
-                             name);
+                             name.str());
   }
   if (!modifiers->isPublic() && !modifiers->isProtected()) {
     throw std::runtime_error(
-        "A method must have a visibility modifier for method " + name);
+        "A method must have a visibility modifier for method " + name.str());
   }
   if (modifiers->isAbstract() &&
       (modifiers->isStatic() || modifiers->isFinal())) {
     throw std::runtime_error("An abstract method cannot be static or final for "
                              "method " +
-                             name);
+                             name.str());
   }
   if (modifiers->isStatic() && modifiers->isFinal()) {
     throw std::runtime_error("A static method cannot be final for method " +
-                             name);
+                             name.str());
   }
 
   // check native methods
   if (modifiers->isNative()) {
     if (!modifiers->isStatic()) {
       throw std::runtime_error("A native method must be static for method " +
-                               name);
+                               name.str());
     }
-    if (params.size() != 1) {
+    if (this->params.size() != 1) {
       throw std::runtime_error("A native method must have exactly one "
                                "parameter for method " +
-                               name);
+                               name.str());
     }
     if (auto type = std::dynamic_pointer_cast<BasicType>(returnType)) {
       if (type->getType() != BasicType::Type::Int) {
         throw std::runtime_error("A native method must return int for method " +
-                                 name);
+                                 name.str());
       }
     }
     if (auto type =
-            std::dynamic_pointer_cast<BasicType>(params[0]->getType())) {
+            std::dynamic_pointer_cast<BasicType>(this->params[0]->getType())) {
       if (type->getType() != BasicType::Type::Int) {
         throw std::runtime_error("A native method must have parameter of type "
                                  "int for method " +
-                                 name);
+                                 name.str());
       }
     }
   }
   checkSuperThisCalls(methodBody);
 
   // set params
-  for (auto &param : params) {
+  for (auto &param : this->params) {
     if (!param)
       throw std::runtime_error("Param cannot be null");
     param->setInParam();
@@ -397,11 +427,12 @@ void MethodDecl::checkSuperThisCalls(std::shared_ptr<Block> block) const {
 }
 
 FieldDecl::FieldDecl(std::shared_ptr<Modifiers> modifiers,
-                     std::shared_ptr<Type> type, std::string name,
+                     std::shared_ptr<Type> type, Symbol name,
                      std::shared_ptr<Expr> initializer,
-                     std::shared_ptr<ScopeID> scope,
-                     const source::SourceRange &loc, bool allowFinal)
-    : modifiers{modifiers}, VarDecl{type, name, initializer, scope, loc} {
+                     ScopeID scope, const source::SourceRange &loc,
+                     bool allowFinal)
+    : modifiers{modifiers},
+      VarDecl{type, name, initializer, std::move(scope), loc} {
   if (!modifiers) {
     throw std::runtime_error("Field Decl Invalid modifiers.");
   }
@@ -546,7 +577,7 @@ std::ostream &VarDecl::print(std::ostream &os, int indent) const {
 
   // Print Scope
   printIndent(os, indent + 1);
-  os << "ScopeID: " << *scope << "\n";
+  os << "ScopeID: " << scope << "\n";
 
   // print location
   printIndent(os, indent + 1);
@@ -768,17 +799,9 @@ void FieldDecl::setParent(std::shared_ptr<CodeBody> parent) {
   }
 }
 
-bool ReferenceType::operator==(const Type &other) const {
-  const ReferenceType *otherRef = dynamic_cast<const ReferenceType *>(&other);
-  if (!otherRef) {
-    return false;
-  }
-
-  if (resolvedDecl.getAstNode() != otherRef->resolvedDecl.getAstNode()) {
-    return false;
-  }
-
-  return true;
+bool ReferenceType::equals(const Type &other) const {
+  return resolvedDecl.getAstNode() ==
+         static_cast<const ReferenceType &>(other).resolvedDecl.getAstNode();
 }
 
 std::ostream &ReferenceType::print(std::ostream &os, int indent) const {
@@ -804,8 +827,7 @@ void ReferenceType::setResolvedDecl(static_check::Decl resolvedDecl) {
   if (!decl) {
     throw std::runtime_error("Decl not resolved when setResolvedDecl");
   }
-  std::cout << "setResolvedDecl for " << decl->getFullName() << std::endl;
-  this->resolvedDecl = resolvedDecl;
+  assignResolvedDecl(resolvedDecl);
   // auto declAst = resolvedDecl->getAstNode();
   // if (!declAst) {
   //   throw std::runtime_error("Decl not resolved");
@@ -817,15 +839,14 @@ void ReferenceType::setResolvedDecl(static_check::Decl resolvedDecl) {
   // }
 }
 
-bool ReferenceType::isString() const {
-  if (isResolved()) {
-    auto decl = std::dynamic_pointer_cast<Decl>(resolvedDecl.getAstNode());
-    if (!decl) {
-      throw std::runtime_error("Decl not resolved");
-    }
-    return decl->getName() == "String";
+void ReferenceType::assignResolvedDecl(static_check::Decl resolvedDecl) {
+  this->resolvedDecl = resolvedDecl;
+  auto decl = resolvedDecl.getAstNode();
+  if (decl && decl->getName() == "String") {
+    flags |= StringFlag;
+  } else {
+    flags &= ~StringFlag;
   }
-  return false;
 }
 
 // std::unordered_set<std::shared_ptr<MethodDecl>>
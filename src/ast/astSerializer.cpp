@@ -0,0 +1,1012 @@
+#include "ast/astSerializer.hpp"
+#include "ast/ast.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <tuple>
+#include <typeindex>
+
+namespace parsetree::ast {
+
+namespace {
+
+constexpr char MAGIC[8] = {'J', 'O', 'O', 'S', 'A', 'S', 'T', '\0'};
+
+// In front of every node, scope table and Modifiers
+enum Ref : uint8_t { NULL_REF, BACK_REF, INLINE };
+
+template <typename T> void writeRaw(std::string &out, T value) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+void writeString(std::string &out, std::string_view str) {
+  writeRaw<uint32_t>(out, str.size());
+  out.append(str);
+}
+
+void writeRange(std::string &out, const source::SourceRange &loc) {
+  writeRaw<int32_t>(out, loc.fileID);
+  writeRaw<uint32_t>(out, loc.offset);
+  writeRaw<uint32_t>(out, loc.length);
+}
+
+std::runtime_error malformed() {
+  return std::runtime_error("Checked AST is malformed");
+}
+
+template <typename T> T readRaw(std::string_view &in) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  if (in.size() < sizeof(T))
+    throw std::runtime_error("Checked AST is truncated");
+  T value;
+  std::memcpy(&value, in.data(), sizeof(T));
+  in.remove_prefix(sizeof(T));
+  return value;
+}
+
+std::string readString(std::string_view &in) {
+  auto size = readRaw<uint32_t>(in);
+  if (in.size() < size)
+    throw std::runtime_error("Checked AST is truncated");
+  std::string str{in.substr(0, size)};
+  in.remove_prefix(size);
+  return str;
+}
+
+// Names are interned straight from the buffer, like the lexer does
+Symbol readSymbol(std::string_view &in) {
+  auto size = readRaw<uint32_t>(in);
+  if (in.size() < size)
+    throw std::runtime_error("Checked AST is truncated");
+  Symbol symbol{in.substr(0, size)};
+  in.remove_prefix(size);
+  return symbol;
+}
+
+source::SourceRange readRange(std::string_view &in) {
+  source::SourceRange loc;
+  loc.fileID = readRaw<int32_t>(in);
+  loc.offset = readRaw<uint32_t>(in);
+  loc.length = readRaw<uint32_t>(in);
+  return loc;
+}
+
+// Ids are dense and start at 1, 0 is never used
+template <typename T>
+void store(std::vector<std::shared_ptr<T>> &table, uint32_t id,
+           std::shared_ptr<T> value) {
+  if (id == 0 || id > (1u << 30))
+    throw malformed();
+  if (id >= table.size())
+    table.resize(id + 1);
+  table[id] = std::move(value);
+}
+
+template <typename T>
+const std::shared_ptr<T> &lookup(const std::vector<std::shared_ptr<T>> &table,
+                                 uint32_t id) {
+  if (id >= table.size() || !table[id])
+    throw malformed();
+  return table[id];
+}
+
+const void *keyOf(const AstNode *node) {
+  return dynamic_cast<const void *>(node);
+}
+
+// Same order when writing and reading
+auto javaLangDecls(auto &javaLang) {
+  return std::tie(javaLang.Array, javaLang.Arrays, javaLang.Boolean,
+                  javaLang.Byte, javaLang.Character, javaLang.Class,
+                  javaLang.Cloneable, javaLang.Integer, javaLang.Number,
+                  javaLang.Object, javaLang.Short, javaLang.String,
+                  javaLang.System, javaLang.Serializable);
+}
+
+enum ModifierBits : uint8_t {
+  PUBLIC = 1 << 0,
+  PROTECTED = 1 << 1,
+  STATIC = 1 << 2,
+  FINAL = 1 << 3,
+  ABSTRACT = 1 << 4,
+  NATIVE = 1 << 5
+};
+
+} // namespace
+
+ASTSerializer::Tag ASTSerializer::tagOf(const AstNode &node) {
+  // By exact type, subclasses (FieldDecl, MethodName, ...) have their own
+  static const std::unordered_map<std::type_index, Tag> tags = {
+      {typeid(ProgramDecl), Tag::ProgramDecl},
+      {typeid(ImportDecl), Tag::ImportDecl},
+      {typeid(ClassDecl), Tag::ClassDecl},
+      {typeid(InterfaceDecl), Tag::InterfaceDecl},
+      {typeid(MethodDecl), Tag::MethodDecl},
+      {typeid(FieldDecl), Tag::FieldDecl},
+      {typeid(VarDecl), Tag::VarDecl},
+      {typeid(Block), Tag::Block},
+      {typeid(IfStmt), Tag::IfStmt},
+      {typeid(WhileStmt), Tag::WhileStmt},
+      {typeid(ForStmt), Tag::ForStmt},
+      {typeid(ReturnStmt), Tag::ReturnStmt},
+      {typeid(ExpressionStmt), Tag::ExpressionStmt},
+      {typeid(DeclStmt), Tag::DeclStmt},
+      {typeid(NullStmt), Tag::NullStmt},
+      {typeid(Expr), Tag::Expr},
+      {typeid(ReferenceType), Tag::ReferenceType},
+      {typeid(UnresolvedType), Tag::UnresolvedType},
+      {typeid(BasicType), Tag::BasicType},
+      {typeid(ArrayType), Tag::ArrayType},
+      {typeid(MethodType), Tag::MethodType},
+      {typeid(SimpleName), Tag::SimpleName},
+      {typeid(QualifiedName), Tag::QualifiedName},
+      {typeid(MemberName), Tag::MemberName},
+      {typeid(MethodName), Tag::MethodName},
+      {typeid(TypeNode), Tag::TypeNode},
+      {typeid(ThisNode), Tag::ThisNode},
+      {typeid(Separator), Tag::Separator},
+      {typeid(UnOp), Tag::UnOp},
+      {typeid(BinOp), Tag::BinOp},
+      {typeid(Assignment), Tag::Assignment},
+      {typeid(MethodInvocation), Tag::MethodInvocation},
+      {typeid(ClassCreation), Tag::ClassCreation},
+      {typeid(FieldAccess), Tag::FieldAccess},
+      {typeid(ArrayCreation), Tag::ArrayCreation},
+      {typeid(ArrayAccess), Tag::ArrayAccess},
+      {typeid(Cast), Tag::Cast},
+      {typeid(Literal), Tag::Literal}};
+
+  auto it = tags.find(typeid(node));
+  if (it == tags.end())
+    throw std::runtime_error(std::string("Cannot serialize AST node of type ") +
+                             typeid(node).name());
+  return it->second;
+}
+
+// Writing ////////////////////////////////////////////////////////////
+
+uint32_t ASTSerializer::idOf(const std::shared_ptr<AstNode> &node) {
+  auto [it, inserted] = nodeIds.try_emplace(keyOf(node.get()), 0);
+  if (inserted) {
+    it->second = nodeIds.size();
+    pending.push_back(node);
+  }
+  return it->second;
+}
+
+void ASTSerializer::writeNode(const std::shared_ptr<AstNode> &node) {
+  if (!node) {
+    writeRaw<uint8_t>(out, NULL_REF);
+    return;
+  }
+  const uint32_t id = idOf(node);
+  if (!written.insert(keyOf(node.get())).second) {
+    writeRaw<uint8_t>(out, BACK_REF);
+    writeRaw<uint32_t>(out, id);
+    return;
+  }
+  writeRaw<uint8_t>(out, INLINE);
+  writeRaw<uint32_t>(out, id);
+  writeBody(node);
+}
+
+void ASTSerializer::writeLink(const std::shared_ptr<AstNode> &node) {
+  if (!node) {
+    writeRaw<uint8_t>(out, NULL_REF);
+    return;
+  }
+  writeRaw<uint8_t>(out, BACK_REF);
+  writeRaw<uint32_t>(out, idOf(node));
+}
+
+template <typename T>
+void ASTSerializer::writeNodes(const std::vector<std::shared_ptr<T>> &nodes) {
+  writeRaw<uint32_t>(out, nodes.size());
+  for (const auto &node : nodes) {
+    writeNode(node);
+  }
+}
+
+void ASTSerializer::writeScope(const ScopeID &scope) {
+  if (!scope) {
+    writeRaw<uint8_t>(out, NULL_REF);
+    return;
+  }
+  auto [it, inserted] = scopeTableIds.try_emplace(scope.table().get(), 0);
+  if (inserted) {
+    it->second = scopeTableIds.size();
+    writeRaw<uint8_t>(out, INLINE);
+    writeRaw<uint32_t>(out, it->second);
+    const auto &scopes = scope.table()->scopes;
+    writeRaw<uint32_t>(out, scopes.size());
+    for (const auto &entry : scopes) {
+      writeRaw<int32_t>(out, entry.parent);
+      writeRaw<int32_t>(out, entry.end);
+    }
+  } else {
+    writeRaw<uint8_t>(out, BACK_REF);
+    writeRaw<uint32_t>(out, it->second);
+  }
+  writeRaw<int32_t>(out, scope.pos());
+}
+
+void ASTSerializer::writeModifiers(const std::shared_ptr<Modifiers> &mods) {
+  if (!mods) {
+    writeRaw<uint8_t>(out, NULL_REF);
+    return;
+  }
+  auto [it, inserted] = modifierIds.try_emplace(mods.get(), 0);
+  if (!inserted) {
+    writeRaw<uint8_t>(out, BACK_REF);
+    writeRaw<uint32_t>(out, it->second);
+    return;
+  }
+  it->second = modifierIds.size();
+  writeRaw<uint8_t>(out, INLINE);
+  writeRaw<uint32_t>(out, it->second);
+  writeRaw<uint8_t>(out, (mods->isPublic() ? PUBLIC : 0) |
+                             (mods->isProtected() ? PROTECTED : 0) |
+                             (mods->isStatic() ? STATIC : 0) |
+                             (mods->isFinal() ? FINAL : 0) |
+                             (mods->isAbstract() ? ABSTRACT : 0) |
+                             (mods->isNative() ? NATIVE : 0));
+}
+
+void ASTSerializer::writeDecl(const Decl &decl) {
+  writeRange(out, decl.loc);
+  writeString(out, decl.fullName);
+  writeLink(decl.getParent());
+}
+
+void ASTSerializer::writeValue(const ExprValue &value) {
+  writeLink(value.getResolvedDecl());
+  writeLink(value.getType());
+}
+
+void ASTSerializer::writeOp(const ExprOp &op) {
+  writeLink(op.getResultType());
+}
+
+void ASTSerializer::writeBody(const std::shared_ptr<AstNode> &node) {
+  const Tag tag = tagOf(*node);
+  writeRaw<uint8_t>(out, static_cast<uint8_t>(tag));
+
+  switch (tag) {
+  case Tag::ProgramDecl: {
+    auto program = std::dynamic_pointer_cast<ProgramDecl>(node);
+    writeNode(program->getPackage());
+    writeNodes(program->getImports());
+    writeNode(program->getBody());
+    break;
+  }
+  case Tag::ImportDecl: {
+    auto import = std::dynamic_pointer_cast<ImportDecl>(node);
+    writeNode(import->getQualifiedIdentifier());
+    writeRaw<uint8_t>(out, import->hasStar());
+    break;
+  }
+  case Tag::ClassDecl: {
+    auto classDecl = std::dynamic_pointer_cast<ClassDecl>(node);
+    writeString(out, classDecl->getName());
+    writeModifiers(classDecl->modifiers);
+    writeNodes(classDecl->superClasses);
+    writeNodes(classDecl->interfaces);
+    writeNodes(classDecl->classBodyDecls);
+    writeRaw<uint32_t>(out, classDecl->allMethods.size());
+    for (const auto &method : classDecl->allMethods) {
+      writeLink(method);
+    }
+    writeDecl(*classDecl);
+    break;
+  }
+  case Tag::InterfaceDecl: {
+    auto interfaceDecl = std::dynamic_pointer_cast<InterfaceDecl>(node);
+    writeString(out, interfaceDecl->getName());
+    writeModifiers(interfaceDecl->modifiers);
+    writeNodes(interfaceDecl->interfaces);
+    writeNode(interfaceDecl->objectType);
+    writeNodes(interfaceDecl->interfaceBodyDecls);
+    writeRaw<uint32_t>(out, interfaceDecl->allMethods.size());
+    for (const auto &method : interfaceDecl->allMethods) {
+      writeLink(method);
+    }
+    writeDecl(*interfaceDecl);
+    break;
+  }
+  case Tag::MethodDecl: {
+    auto method = std::dynamic_pointer_cast<MethodDecl>(node);
+    writeString(out, method->getName());
+    writeModifiers(method->getModifiers());
+    writeNode(method->getReturnType());
+    writeRaw<uint8_t>(out, method->isConstructor());
+    writeNodes(method->getParams());
+    writeNode(method->getMethodBody());
+    writeNodes(method->getLocalDecls());
+    writeDecl(*method);
+    break;
+  }
+  case Tag::FieldDecl:
+  case Tag::VarDecl: {
+    auto var = std::dynamic_pointer_cast<VarDecl>(node);
+    if (auto field = std::dynamic_pointer_cast<FieldDecl>(node))
+      writeModifiers(field->getModifiers());
+    writeString(out, var->getName());
+    writeNode(var->getType());
+    writeNode(var->getInitializer());
+    writeScope(var->getScope());
+    writeRaw<uint8_t>(out, var->isInParam());
+    writeLink(var->getRealType());
+    writeDecl(*var);
+    break;
+  }
+  case Tag::Block:
+    writeNodes(std::dynamic_pointer_cast<Block>(node)->getStatements());
+    break;
+  case Tag::IfStmt: {
+    auto stmt = std::dynamic_pointer_cast<IfStmt>(node);
+    writeNode(stmt->getCondition());
+    writeNode(stmt->getIfBody());
+    writeNode(stmt->getElseBody());
+    break;
+  }
+  case Tag::WhileStmt: {
+    auto stmt = std::dynamic_pointer_cast<WhileStmt>(node);
+    writeNode(stmt->getCondition());
+    writeNode(stmt->getWhileBody());
+    break;
+  }
+  case Tag::ForStmt: {
+    auto stmt = std::dynamic_pointer_cast<ForStmt>(node);
+    writeNode(stmt->getForInit());
+    writeNode(stmt->getCondition());
+    writeNode(stmt->getForUpdate());
+    writeNode(stmt->getForBody());
+    break;
+  }
+  case Tag::ReturnStmt:
+    writeNode(std::dynamic_pointer_cast<ReturnStmt>(node)->getReturnExpr());
+    break;
+  case Tag::ExpressionStmt:
+    writeNode(
+        std::dynamic_pointer_cast<ExpressionStmt>(node)->getStatementExpr());
+    break;
+  case Tag::DeclStmt:
+    writeNode(std::dynamic_pointer_cast<DeclStmt>(node)->getDecl());
+    break;
+  case Tag::NullStmt:
+    break;
+  case Tag::Expr: {
+    auto expr = std::dynamic_pointer_cast<Expr>(node);
+    writeNodes(expr->getExprNodes());
+    writeScope(expr->getScope());
+    break;
+  }
+  case Tag::UnresolvedType: {
+    auto &identifiers =
+        std::dynamic_pointer_cast<UnresolvedType>(node)->getIdentifiers();
+    writeRaw<uint32_t>(out, identifiers.size());
+    for (const auto &identifier : identifiers) {
+      writeString(out, identifier.view());
+    }
+    [[fallthrough]];
+  }
+  case Tag::ReferenceType: {
+    auto type = std::dynamic_pointer_cast<ReferenceType>(node);
+    writeLink(type->decl);
+    writeLink(type->resolvedDecl.getAstNode());
+    break;
+  }
+  case Tag::BasicType:
+    writeRaw<uint8_t>(out, static_cast<uint8_t>(
+                               std::dynamic_pointer_cast<BasicType>(node)
+                                   ->getType()));
+    break;
+  case Tag::ArrayType:
+    writeNode(std::dynamic_pointer_cast<ArrayType>(node)->getElementType());
+    break;
+  case Tag::MethodType: {
+    auto type = std::dynamic_pointer_cast<MethodType>(node);
+    writeNode(type->getReturnType());
+    writeNodes(type->getParamTypes());
+    break;
+  }
+  case Tag::SimpleName: {
+    auto name = std::dynamic_pointer_cast<SimpleName>(node);
+    writeString(out, name->getName());
+    writeRaw<uint8_t>(out, name->getShouldBeStatic());
+    writeValue(*name);
+    break;
+  }
+  case Tag::QualifiedName: {
+    auto name = std::dynamic_pointer_cast<QualifiedName>(node);
+    writeRaw<uint32_t>(out, name->size());
+    for (int i = 0; i < name->size(); ++i) {
+      writeNode(name->get(i));
+    }
+    break;
+  }
+  case Tag::MemberName:
+  case Tag::MethodName: {
+    auto name = std::dynamic_pointer_cast<MemberName>(node);
+    writeString(out, name->getName());
+    writeRange(out, name->getLoc());
+    writeRaw<uint8_t>(out, name->isAccessedByThis());
+    writeRaw<uint8_t>(out, name->isNotAsBase());
+    writeRaw<uint8_t>(out, name->isinitializedInExpr());
+    writeValue(*name);
+    break;
+  }
+  case Tag::TypeNode:
+  case Tag::ThisNode:
+    writeValue(*std::dynamic_pointer_cast<ExprValue>(node));
+    break;
+  case Tag::Separator:
+    break;
+  case Tag::UnOp: {
+    auto op = std::dynamic_pointer_cast<UnOp>(node);
+    writeRaw<uint8_t>(out, static_cast<uint8_t>(op->getOp()));
+    writeOp(*op);
+    break;
+  }
+  case Tag::BinOp: {
+    auto op = std::dynamic_pointer_cast<BinOp>(node);
+    writeRaw<uint8_t>(out, static_cast<uint8_t>(op->getOp()));
+    writeLink(op->getLhsType());
+    writeLink(op->getRhsType());
+    writeOp(*op);
+    break;
+  }
+  case Tag::Assignment: {
+    auto op = std::dynamic_pointer_cast<Assignment>(node);
+    writeLink(op->getAssignedVariable());
+    writeOp(*op);
+    break;
+  }
+  case Tag::MethodInvocation: {
+    auto op = std::dynamic_pointer_cast<MethodInvocation>(node);
+    writeRaw<int32_t>(out, op->getNumArgs());
+    writeNodes(op->getQualifiedIdentifier());
+    writeOp(*op);
+    break;
+  }
+  case Tag::ClassCreation: {
+    auto op = std::dynamic_pointer_cast<ClassCreation>(node);
+    writeRaw<int32_t>(out, op->getNumArgs());
+    writeOp(*op);
+    break;
+  }
+  case Tag::FieldAccess:
+  case Tag::ArrayCreation:
+  case Tag::ArrayAccess:
+    writeOp(*std::dynamic_pointer_cast<ExprOp>(node));
+    break;
+  case Tag::Cast: {
+    auto op = std::dynamic_pointer_cast<Cast>(node);
+    writeLink(op->getRhsLiteral());
+    writeOp(*op);
+    break;
+  }
+  case Tag::Literal: {
+    auto literal = std::dynamic_pointer_cast<Literal>(node);
+    writeRaw<uint8_t>(out, static_cast<uint8_t>(literal->getLiteralType()));
+    writeRaw<uint8_t>(out, literal->isString());
+    if (literal->isString())
+      writeString(out, literal->getAsString());
+    else
+      writeRaw<int64_t>(out, literal->getAsInt());
+    writeValue(*literal);
+    break;
+  }
+  }
+}
+
+std::string ASTSerializer::serialize(const ASTManager &manager) {
+  ASTSerializer writer;
+  auto &out = writer.out;
+  out.append(MAGIC, sizeof(MAGIC));
+  writeRaw<uint32_t>(out, VERSION);
+
+  writeRaw<uint32_t>(out, manager.getASTs().size());
+  for (const auto &ast : manager.getASTs()) {
+    writer.writeNode(ast);
+  }
+  std::apply([&](const auto &...decl) { (writer.writeLink(decl), ...); },
+             javaLangDecls(manager.java_lang));
+  writeRaw<uint32_t>(out, manager.allDecls.size());
+  for (const auto &decl : manager.allDecls) {
+    writer.writeLink(decl);
+  }
+
+  // Nodes only ever linked to, e.g. types made up by the type checker.
+  // Writing them can link to more, so pending keeps growing.
+  for (size_t i = 0; i < writer.pending.size(); ++i) {
+    auto node = writer.pending[i];
+    if (writer.written.contains(keyOf(node.get())))
+      continue;
+    writeRaw<uint8_t>(out, 1);
+    writer.writeNode(node);
+  }
+  writeRaw<uint8_t>(out, 0);
+  return std::move(out);
+}
+
+void ASTSerializer::save(const ASTManager &manager, const std::string &path) {
+  const std::string data = serialize(manager);
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file.is_open())
+    throw std::runtime_error("Could not open checked AST " + path +
+                             " for writing");
+  file.write(data.data(), data.size());
+}
+
+// Reading ////////////////////////////////////////////////////////////
+
+std::shared_ptr<AstNode> ASTSerializer::readNode() {
+  switch (readRaw<uint8_t>(in)) {
+  case NULL_REF:
+    return nullptr;
+  case BACK_REF:
+    // Owned nodes are always written before anything refers back to them
+    return lookup(nodes, readRaw<uint32_t>(in));
+  case INLINE: {
+    const auto id = readRaw<uint32_t>(in);
+    const auto tag = readRaw<uint8_t>(in);
+    if (tag > static_cast<uint8_t>(Tag::Literal))
+      throw malformed();
+    auto node = readBody(static_cast<Tag>(tag));
+    store(nodes, id, node);
+    return node;
+  }
+  default:
+    throw malformed();
+  }
+}
+
+template <typename T> std::shared_ptr<T> ASTSerializer::readNodeAs() {
+  auto node = readNode();
+  if (!node)
+    return nullptr;
+  auto typed = std::dynamic_pointer_cast<T>(node);
+  if (!typed)
+    throw malformed();
+  return typed;
+}
+
+template <typename T>
+std::vector<std::shared_ptr<T>> ASTSerializer::readNodes() {
+  const auto size = readRaw<uint32_t>(in);
+  std::vector<std::shared_ptr<T>> result;
+  result.reserve(std::min<size_t>(size, in.size()));
+  for (uint32_t i = 0; i < size; ++i) {
+    result.push_back(readNodeAs<T>());
+  }
+  return result;
+}
+
+template <typename T>
+void ASTSerializer::readLink(std::function<void(std::shared_ptr<T>)> assign) {
+  const auto ref = readRaw<uint8_t>(in);
+  if (ref == NULL_REF)
+    return;
+  if (ref != BACK_REF)
+    throw malformed();
+  fixups.push_back([this, id = readRaw<uint32_t>(in),
+                    assign = std::move(assign)]() { assign(nodeAt<T>(id)); });
+}
+
+template <typename T>
+std::shared_ptr<T> ASTSerializer::nodeAt(uint32_t id) const {
+  auto typed = std::dynamic_pointer_cast<T>(lookup(nodes, id));
+  if (!typed)
+    throw malformed();
+  return typed;
+}
+
+ScopeID ASTSerializer::readScope() {
+  std::shared_ptr<ScopeTable> table;
+  switch (readRaw<uint8_t>(in)) {
+  case NULL_REF:
+    return ScopeID{};
+  case BACK_REF:
+    table = lookup(scopeTables, readRaw<uint32_t>(in));
+    break;
+  case INLINE: {
+    const auto id = readRaw<uint32_t>(in);
+    table = std::make_shared<ScopeTable>();
+    const auto size = readRaw<uint32_t>(in);
+    for (uint32_t i = 0; i < size; ++i) {
+      const auto parent = readRaw<int32_t>(in);
+      const auto end = readRaw<int32_t>(in);
+      // parents come first in pre-order
+      if (parent < ScopeTable::NO_PARENT || parent >= static_cast<int>(i))
+        throw malformed();
+      // a closed block ends after its opener and within the table
+      if (end != INT_MAX && (end <= static_cast<int64_t>(i) ||
+                             end > static_cast<int64_t>(size)))
+        throw malformed();
+      table->scopes.push_back({parent, end});
+    }
+    store(scopeTables, id, table);
+    break;
+  }
+  default:
+    throw malformed();
+  }
+  const auto pos = readRaw<int32_t>(in);
+  if (pos < 0 || static_cast<size_t>(pos) >= table->scopes.size())
+    throw malformed();
+  return ScopeID{table, pos};
+}
+
+std::shared_ptr<Modifiers> ASTSerializer::readModifiers() {
+  switch (readRaw<uint8_t>(in)) {
+  case NULL_REF:
+    return nullptr;
+  case BACK_REF:
+    return lookup(modifiers, readRaw<uint32_t>(in));
+  case INLINE: {
+    const auto id = readRaw<uint32_t>(in);
+    const auto bits = readRaw<uint8_t>(in);
+    auto mods = context.make<Modifiers>();
+    if (bits & PUBLIC)
+      mods->setPublic();
+    if (bits & PROTECTED)
+      mods->setProtected();
+    if (bits & STATIC)
+      mods->setStatic();
+    if (bits & FINAL)
+      mods->setFinal();
+    if (bits & ABSTRACT)
+      mods->setAbstract();
+    if (bits & NATIVE)
+      mods->setNative();
+    store(modifiers, id, mods);
+    return mods;
+  }
+  default:
+    throw malformed();
+  }
+}
+
+void ASTSerializer::readDecl(const std::shared_ptr<Decl> &decl) {
+  decl->loc = readRange(in);
+  decl->fullName = readString(in);
+  readLink<CodeBody>([decl](auto parent) { decl->parent = parent; });
+}
+
+void ASTSerializer::readValue(const std::shared_ptr<ExprValue> &value) {
+  readLink<Decl>([value](auto decl) { value->decl_ = decl; });
+  readLink<Type>([value](auto type) { value->type_ = type; });
+}
+
+void ASTSerializer::readOp(const std::shared_ptr<ExprOp> &op) {
+  readLink<Type>([op](auto type) { op->resultType = type; });
+}
+
+std::shared_ptr<AstNode> ASTSerializer::readBody(Tag tag) {
+  // Constructor arguments are read into locals first, the order of
+  // evaluation of function arguments is unspecified
+  switch (tag) {
+  case Tag::ProgramDecl: {
+    auto package = readNodeAs<ReferenceType>();
+    auto imports = readNodes<ImportDecl>();
+    auto body = readNodeAs<CodeBody>();
+    return context.make<ProgramDecl>(package, imports, body);
+  }
+  case Tag::ImportDecl: {
+    auto qualifiedIdentifier = readNodeAs<ReferenceType>();
+    bool hasStar = readRaw<uint8_t>(in);
+    return context.make<ImportDecl>(qualifiedIdentifier, hasStar);
+  }
+  case Tag::ClassDecl: {
+    auto name = readSymbol(in);
+    auto mods = readModifiers();
+    auto superClasses = readNodes<ReferenceType>();
+    auto interfaces = readNodes<ReferenceType>();
+    auto body = readNodes<Decl>();
+    std::shared_ptr<ClassDecl> classDecl;
+    if (mods) {
+      classDecl = context.make<ClassDecl>(
+          mods, name, superClasses.size() > 0 ? superClasses[0] : nullptr,
+          superClasses.size() > 1 ? superClasses[1] : nullptr, interfaces,
+          body);
+    } else {
+      classDecl = context.make<ClassDecl>(name);
+    }
+    // java.lang.Object had its super classes cleared
+    classDecl->superClasses = std::move(superClasses);
+    const auto numMethods = readRaw<uint32_t>(in);
+    for (uint32_t i = 0; i < numMethods; ++i) {
+      readLink<MethodDecl>(
+          [classDecl](auto method) { classDecl->allMethods.insert(method); });
+    }
+    readDecl(classDecl);
+    return classDecl;
+  }
+  case Tag::InterfaceDecl: {
+    auto name = readSymbol(in);
+    auto mods = readModifiers();
+    auto interfaces = readNodes<ReferenceType>();
+    auto objectType = readNodeAs<ReferenceType>();
+    auto body = readNodes<Decl>();
+    auto interfaceDecl = context.make<InterfaceDecl>(mods, name, interfaces,
+                                                     objectType, body);
+    const auto numMethods = readRaw<uint32_t>(in);
+    for (uint32_t i = 0; i < numMethods; ++i) {
+      readLink<MethodDecl>([interfaceDecl](auto method) {
+        interfaceDecl->allMethods.insert(method);
+      });
+    }
+    readDecl(interfaceDecl);
+    return interfaceDecl;
+  }
+  case Tag::MethodDecl: {
+    auto name = readSymbol(in);
+    auto mods = readModifiers();
+    auto returnType = readNodeAs<Type>();
+    bool isConstructor = readRaw<uint8_t>(in);
+    auto params = readNodes<VarDecl>();
+    auto body = readNodeAs<Block>();
+    auto localDecls = readNodes<VarDecl>();
+    auto method = context.make<MethodDecl>(mods, name, returnType, params,
+                                           isConstructor, body,
+                                           source::SourceRange{});
+    method->addDecls(localDecls);
+    readDecl(method);
+    return method;
+  }
+  case Tag::FieldDecl:
+  case Tag::VarDecl: {
+    auto mods = tag == Tag::FieldDecl ? readModifiers() : nullptr;
+    auto name = readSymbol(in);
+    auto type = readNodeAs<Type>();
+    auto initializer = readNodeAs<Expr>();
+    auto scope = readScope();
+    // final fields were already allowed or rejected when checking
+    auto var = tag == Tag::FieldDecl
+                   ? context.make<FieldDecl>(mods, type, name, initializer,
+                                             scope, source::SourceRange{},
+                                             true)
+                   : context.make<VarDecl>(type, name, initializer, scope,
+                                           source::SourceRange{});
+    if (readRaw<uint8_t>(in))
+      var->setInParam();
+    readLink<Type>([var](auto type) { var->setRealType(type); });
+    readDecl(var);
+    return var;
+  }
+  case Tag::Block:
+    return context.make<Block>(readNodes<Stmt>());
+  case Tag::IfStmt: {
+    auto condition = readNodeAs<Expr>();
+    auto ifBody = readNodeAs<Stmt>();
+    auto elseBody = readNodeAs<Stmt>();
+    return context.make<IfStmt>(condition, ifBody, elseBody);
+  }
+  case Tag::WhileStmt: {
+    auto condition = readNodeAs<Expr>();
+    auto whileBody = readNodeAs<Stmt>();
+    return context.make<WhileStmt>(condition, whileBody);
+  }
+  case Tag::ForStmt: {
+    auto forInit = readNodeAs<Stmt>();
+    auto condition = readNodeAs<Expr>();
+    auto forUpdate = readNodeAs<Stmt>();
+    auto forBody = readNodeAs<Stmt>();
+    return context.make<ForStmt>(forInit, condition, forUpdate, forBody);
+  }
+  case Tag::ReturnStmt:
+    return context.make<ReturnStmt>(readNodeAs<Expr>());
+  case Tag::ExpressionStmt:
+    return context.make<ExpressionStmt>(readNodeAs<Expr>());
+  case Tag::DeclStmt:
+    return context.make<DeclStmt>(readNodeAs<VarDecl>());
+  case Tag::NullStmt:
+    return context.make<NullStmt>();
+  case Tag::Expr: {
+    auto exprNodes = readNodes<ExprNode>();
+    auto scope = readScope();
+    return context.make<Expr>(std::move(exprNodes), scope);
+  }
+  case Tag::ReferenceType:
+  case Tag::UnresolvedType: {
+    std::shared_ptr<ReferenceType> type;
+    if (tag == Tag::UnresolvedType) {
+      auto unresolved = context.make<UnresolvedType>();
+      const auto size = readRaw<uint32_t>(in);
+      for (uint32_t i = 0; i < size; ++i) {
+        unresolved->addIdentifier(readSymbol(in));
+      }
+      type = unresolved;
+    } else {
+      type = context.make<ReferenceType>(nullptr);
+    }
+    readLink<Decl>([type](auto decl) { type->decl = decl; });
+    readLink<Decl>([type](auto decl) {
+      type->assignResolvedDecl(static_check::Decl{decl});
+    });
+    return type;
+  }
+  case Tag::BasicType: {
+    auto type = context.make<BasicType>(
+        static_cast<BasicType::Type>(readRaw<uint8_t>(in)));
+    return std::static_pointer_cast<Type>(type);
+  }
+  case Tag::ArrayType: {
+    auto type = context.make<ArrayType>(readNodeAs<Type>());
+    return std::static_pointer_cast<Type>(type);
+  }
+  case Tag::MethodType: {
+    auto returnType = readNodeAs<Type>();
+    auto paramTypes = readNodes<Type>();
+    return context.make<MethodType>(returnType, std::move(paramTypes));
+  }
+  case Tag::SimpleName: {
+    auto name = context.make<SimpleName>(readSymbol(in));
+    if (readRaw<uint8_t>(in))
+      name->setShouldBeStatic();
+    readValue(name);
+    return name;
+  }
+  case Tag::QualifiedName: {
+    auto name = context.make<QualifiedName>();
+    const auto size = readRaw<uint32_t>(in);
+    for (uint32_t i = 0; i < size; ++i) {
+      name->add(readNodeAs<SimpleName>());
+    }
+    return name;
+  }
+  case Tag::MemberName:
+  case Tag::MethodName: {
+    auto memberName = readSymbol(in);
+    auto loc = readRange(in);
+    auto name = tag == Tag::MethodName
+                    ? context.make<MethodName>(memberName, loc)
+                    : context.make<MemberName>(memberName, loc);
+    if (readRaw<uint8_t>(in))
+      name->setAccessedByThis();
+    if (readRaw<uint8_t>(in))
+      name->setNotAsBase();
+    if (readRaw<uint8_t>(in))
+      name->setinitializedInExpr();
+    readValue(name);
+    return name;
+  }
+  case Tag::TypeNode: {
+    auto value = context.make<TypeNode>(nullptr);
+    readValue(value);
+    return value;
+  }
+  case Tag::ThisNode: {
+    auto value = context.make<ThisNode>();
+    readValue(value);
+    return value;
+  }
+  case Tag::Separator:
+    return context.make<Separator>();
+  case Tag::UnOp: {
+    auto op =
+        context.make<UnOp>(static_cast<UnOp::OpType>(readRaw<uint8_t>(in)));
+    readOp(op);
+    return op;
+  }
+  case Tag::BinOp: {
+    auto op =
+        context.make<BinOp>(static_cast<BinOp::OpType>(readRaw<uint8_t>(in)));
+    readLink<Type>([op](auto type) { op->setLhsType(type); });
+    readLink<Type>([op](auto type) { op->setRhsType(type); });
+    readOp(op);
+    return op;
+  }
+  case Tag::Assignment: {
+    auto op = context.make<Assignment>();
+    readLink<VarDecl>([op](auto var) { op->setAssignedVariable(var); });
+    readOp(op);
+    return op;
+  }
+  case Tag::MethodInvocation: {
+    const auto numArgs = readRaw<int32_t>(in);
+    auto qualifiedIdentifier = readNodes<ExprNode>();
+    auto op =
+        context.make<MethodInvocation>(numArgs, std::move(qualifiedIdentifier));
+    readOp(op);
+    return op;
+  }
+  case Tag::ClassCreation: {
+    auto op = context.make<ClassCreation>(readRaw<int32_t>(in));
+    readOp(op);
+    return op;
+  }
+  case Tag::FieldAccess: {
+    auto op = context.make<FieldAccess>();
+    readOp(op);
+    return op;
+  }
+  case Tag::ArrayCreation: {
+    auto op = context.make<ArrayCreation>();
+    readOp(op);
+    return op;
+  }
+  case Tag::ArrayAccess: {
+    auto op = context.make<ArrayAccess>();
+    readOp(op);
+    return op;
+  }
+  case Tag::Cast: {
+    auto op = context.make<Cast>();
+    readLink<Literal>([op](auto literal) { op->setRhsLiteral(literal); });
+    readOp(op);
+    return op;
+  }
+  case Tag::Literal: {
+    const auto literalType = static_cast<Literal::Type>(readRaw<uint8_t>(in));
+    std::variant<int64_t, std::string> value;
+    if (readRaw<uint8_t>(in))
+      value = readString(in);
+    else
+      value = readRaw<int64_t>(in);
+    auto literal =
+        context.make<Literal>(literalType, std::move(value), nullptr);
+    readValue(literal);
+    return literal;
+  }
+  }
+  throw malformed();
+}
+
+std::shared_ptr<ASTManager> ASTSerializer::deserialize(std::string_view data) {
+  ASTSerializer reader;
+  auto &in = reader.in;
+  in = data;
+  if (in.size() < sizeof(MAGIC) ||
+      std::memcmp(in.data(), MAGIC, sizeof(MAGIC)) != 0)
+    throw std::runtime_error("Not a checked AST");
+  in.remove_prefix(sizeof(MAGIC));
+  if (readRaw<uint32_t>(in) != VERSION)
+    throw std::runtime_error("Checked AST was written by a different version");
+
+  auto manager = std::make_shared<ASTManager>();
+  const auto numASTs = readRaw<uint32_t>(in);
+  for (uint32_t i = 0; i < numASTs; ++i) {
+    manager->addAST(reader.readNodeAs<ProgramDecl>());
+  }
+  std::apply(
+      [&](auto &...decl) {
+        (reader.readLink<typename std::remove_reference_t<
+             decltype(decl)>::element_type>(
+             [&decl](auto node) { decl = node; }),
+         ...);
+      },
+      javaLangDecls(manager->java_lang));
+  const auto numDecls = readRaw<uint32_t>(in);
+  if (numDecls > in.size())
+    throw malformed();
+  manager->allDecls.resize(numDecls);
+  for (auto &decl : manager->allDecls) {
+    reader.readLink<Decl>([&decl](auto node) { decl = node; });
+  }
+
+  while (readRaw<uint8_t>(in)) {
+    reader.readNode();
+  }
+  if (!in.empty())
+    throw malformed();
+
+  for (auto &fixup : reader.fixups) {
+    fixup();
+  }
+  return manager;
+}
+
+std::shared_ptr<ASTManager> ASTSerializer::load(const std::string &path) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open())
+    throw std::runtime_error("Could not open checked AST " + path);
+  const std::string content((std::istreambuf_iterator<char>(file)),
+                            std::istreambuf_iterator<char>());
+  return deserialize(content);
+}
+
+} // namespace parsetree::ast
@@ -3,42 +3,6 @@
 
 namespace codegen {
 
-// Taken from HierarchyCheck
-static bool isClass(std::shared_ptr<parsetree::ast::AstNode> decl) {
-  return !!std::dynamic_pointer_cast<parsetree::ast::ClassDecl>(decl);
-}
-
-static bool isSuperClass(std::shared_ptr<parsetree::ast::AstNode> super,
-                         std::shared_ptr<parsetree::ast::AstNode> child) {
-  if (!child || !super) {
-    return false;
-  }
-  if (!isClass(child)) {
-    return false;
-  }
-  if (!isClass(super)) {
-    return false;
-  }
-  auto childDecl = std::dynamic_pointer_cast<parsetree::ast::ClassDecl>(child);
-  auto superDecl = std::dynamic_pointer_cast<parsetree::ast::ClassDecl>(super);
-
-  for (auto &superClass : childDecl->getSuperClasses()) {
-    if (!superClass || !superClass->getResolvedDecl().getAstNode())
-      continue;
-    // Cast to class
-    auto superClassDecl = std::dynamic_pointer_cast<parsetree::ast::ClassDecl>(
-        superClass->getResolvedDecl().getAstNode());
-
-    if (superClassDecl == superDecl)
-      return true;
-
-    if (isSuperClass(super, std::dynamic_pointer_cast<parsetree::ast::AstNode>(
-                                superClassDecl)))
-      return true;
-  }
-  return false;
-}
-
 std::shared_ptr<tir::Expr>
 ExprIRConverter::mapValue(std::shared_ptr<parsetree::ast::ExprValue> &value) {
   // std::cout << "mapValue:\n";
@@ -177,7 +141,7 @@ ExprIRConverter::mapValue(std::shared_ptr<parsetree::ast::ExprValue> &value) {
 
       // get chars field
       std::shared_ptr<parsetree::ast::FieldDecl> charsField =
-          stringClass->getField("chars");
+          stringClass->getField(parsetree::Symbol{"chars"});
       if (charsField == nullptr) {
         throw std::runtime_error("Chars field not found in String class");
       }
@@ -640,7 +604,8 @@ std::shared_ptr<tir::Expr> ExprIRConverter::evalStringConcatenation(
       //     std::make_shared<tir::Temp>(newCharsRef)));
     }
     /** New implementation, leverage existing concat call on string */
-    auto concatMethod = astManager->java_lang.String->getMethod("concat");
+    auto concatMethod =
+        astManager->java_lang.String->getMethod(parsetree::Symbol{"concat"});
     if (!concatMethod) {
       throw std::runtime_error("String object has no concat method");
     }
@@ -648,7 +613,7 @@ std::shared_ptr<tir::Expr> ExprIRConverter::evalStringConcatenation(
 
     // Leverage concat method
     auto methodName = std::make_shared<parsetree::ast::MethodName>(
-        concatMethod->getFullName(), source::SourceRange());
+        parsetree::Symbol{concatMethod->getFullName()}, source::SourceRange());
     methodName->setResolvedDecl(concatMethod);
     auto methodNameTIR = std::make_shared<tir::TempTIR>(
         methodName, tir::TempTIR::Type::MethodName);
@@ -809,7 +774,7 @@ std::shared_ptr<tir::Expr> ExprIRConverter::evalStringConcatenation(
 
   // Leverage valueOf method
   auto methodName = std::make_shared<parsetree::ast::MethodName>(
-      valueOfMethod->getFullName(), source::SourceRange());
+      parsetree::Symbol{valueOfMethod->getFullName()}, source::SourceRange());
   methodName->setResolvedDecl(valueOfMethod);
   auto methodNameTIR = std::make_shared<tir::TempTIR>(
       methodName, tir::TempTIR::Type::MethodName);
@@ -823,14 +788,14 @@ std::shared_ptr<tir::Expr> ExprIRConverter::evalStringConcatenation(
   auto newOp = std::make_shared<parsetree::ast::BinOp>(
       parsetree::ast::BinOp::OpType::Add);
   if (!op->getLhsType()->isString()) {
-    newOp->setLhsType(std::make_shared<parsetree::ast::BasicType>(
+    newOp->setLhsType(astManager->types.getBasicType(
         parsetree::ast::BasicType::Type::String));
     newOp->setRhsType(op->getRhsType());
     return evalStringConcatenation(newOp, newString, rhs);
   }
   newOp->setLhsType(op->getLhsType());
-  newOp->setRhsType(std::make_shared<parsetree::ast::BasicType>(
-      parsetree::ast::BasicType::Type::String));
+  newOp->setRhsType(
+      astManager->types.getBasicType(parsetree::ast::BasicType::Type::String));
   return evalStringConcatenation(newOp, lhs, newString);
 }
 
@@ -1031,7 +996,7 @@ ExprIRConverter::evalBinOp(std::shared_ptr<parsetree::ast::BinOp> &op,
                 "InstanceOf array operands cannot be non-class types");
           }
           if (lhsElemDecl == rhsElemDecl ||
-              isSuperClass(rhsElemDecl, lhsElemDecl)) {
+              astManager->hierarchy.isSuperClass(rhsElemDecl, lhsElemDecl)) {
             return std::make_shared<tir::Const>(1);
           }
         }
@@ -1065,7 +1030,8 @@ ExprIRConverter::evalBinOp(std::shared_ptr<parsetree::ast::BinOp> &op,
           }
           // std::cout << "checking instanceof with lhs: " << lhsDecl->getName()
           // << ", rhs: " << rhsDecl->getName() << "\n";
-          if (lhsDecl == rhsDecl || isSuperClass(rhsDecl, lhsDecl)) {
+          if (lhsDecl == rhsDecl ||
+              astManager->hierarchy.isSuperClass(rhsDecl, lhsDecl)) {
             // return std::make_shared<tir::Const>(1);
             return std::make_shared<tir::BinOp>(
                 tir::BinOp::OpType::NEQ, lhs, std::make_shared<tir::Const>(0));
@@ -1892,7 +1858,7 @@ ExprIRConverter::evalCast(std::shared_ptr<parsetree::ast::Cast> &op,
       if (sourceClass == resultClass) {
         // do nothing
         return value;
-      } else if (isSuperClass(resultClass, sourceClass)) {
+      } else if (astManager->hierarchy.isSuperClass(resultClass, sourceClass)) {
         // upcasting
 
         // create cast result
@@ -1,47 +1,56 @@
 #include "parseTree/parseTree.hpp"
 #include "parser/myBisonParser.hpp"
 
+#include <algorithm>
+#include <cstring>
+
 using Node = parsetree::Node;
 using Operator = parsetree::Operator;
 using Literal = parsetree::Literal;
 using Identifier = parsetree::Identifier;
 using Modifier = parsetree::Modifier;
 using BasicType = parsetree::BasicType;
-using Corrupted = parsetree::Corrupted;
-
-std::shared_ptr<Node> myFlexLexer::make_corrupted(const char *name) {
-  auto nodePtr = std::make_shared<Corrupted>(name);
-  nodes.push_back(nodePtr);
-  return nodePtr;
-}
 
 std::shared_ptr<Node> myFlexLexer::make_operator(Operator::Type type) {
-  auto nodePtr = std::make_shared<Operator>(type);
-  nodes.push_back(nodePtr);
-  return nodePtr;
+  return allocate<Operator>(type);
 }
 
 std::shared_ptr<Node> myFlexLexer::make_literal(Literal::Type type,
                                                 const char *value) {
-  auto nodePtr = std::make_shared<Literal>(type, value);
-  nodes.push_back(nodePtr);
-  return nodePtr;
+  auto literal = allocate<Literal>(type, value);
+  // Range checked here rather than in a walk over the finished tree. Only
+  // 2^31 has to wait for the parser to know if it was negated.
+  if (literal->isOutOfRange())
+    set_parse_error("integer literal out of range");
+  else if (!literal->isValid())
+    signDependentLiterals.push_back(literal.get());
+  return literal;
+}
+
+void myFlexLexer::check_literals() {
+  for (auto literal : signDependentLiterals) {
+    if (!literal->isValid()) {
+      set_parse_error("integer literal out of range");
+      return;
+    }
+  }
 }
 
 std::shared_ptr<Node> myFlexLexer::make_identifier(const char *name) {
-  auto nodePtr = std::make_shared<Identifier>(std::string(name));
-  nodes.push_back(nodePtr);
-  return nodePtr;
+  return allocate<Identifier>(name);
 }
 
 std::shared_ptr<Node> myFlexLexer::make_modifier(Modifier::Type type) {
-  auto nodePtr = std::make_shared<Modifier>(type);
-  nodes.push_back(nodePtr);
-  return nodePtr;
+  return allocate<Modifier>(type);
 }
 
 std::shared_ptr<Node> myFlexLexer::make_basic_type(BasicType::Type type) {
-  auto nodePtr = std::make_shared<BasicType>(type);
-  nodes.push_back(nodePtr);
-  return nodePtr;
+  return allocate<BasicType>(type);
+}
+
+int myFlexLexer::LexerInput(char *buf, int max_size) {
+  const size_t n = std::min<size_t>(max_size, input.size());
+  std::memcpy(buf, input.data(), n);
+  input.remove_prefix(n);
+  return static_cast<int>(n);
 }
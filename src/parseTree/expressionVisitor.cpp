@@ -63,58 +63,57 @@ ParseTreeVisitor::visitExpression(const NodePtr &node) {
   // TODO: Code looks repetitive. Will fix later
   switch (node->get_node_type()) {
   case NodeType::Expression:
-    return std::make_shared<ast::Expr>(visitExprNode(node),
-                                       envManager->CurrentScopeID());
+    return context.make<ast::Expr>(visitExprNode(node),
+                                 envManager->CurrentScopeID());
   case NodeType::Assignment:
-    return std::make_shared<ast::Expr>(visitAssignment(node),
-                                       envManager->CurrentScopeID());
+    return context.make<ast::Expr>(visitAssignment(node),
+                                 envManager->CurrentScopeID());
   case NodeType::MethodInvocation:
-    return std::make_shared<ast::Expr>(visitMethodInvocation(node),
-                                       envManager->CurrentScopeID());
+    return context.make<ast::Expr>(visitMethodInvocation(node),
+                                 envManager->CurrentScopeID());
   case NodeType::ArrayAccess:
-    return std::make_shared<ast::Expr>(visitArrayAccess(node),
-                                       envManager->CurrentScopeID());
+    return context.make<ast::Expr>(visitArrayAccess(node),
+                                 envManager->CurrentScopeID());
   case NodeType::FieldAccess:
-    return std::make_shared<ast::Expr>(visitFieldAccess(node),
-                                       envManager->CurrentScopeID());
+    return context.make<ast::Expr>(visitFieldAccess(node),
+                                 envManager->CurrentScopeID());
   case NodeType::Cast:
-    return std::make_shared<ast::Expr>(visitCast(node),
-                                       envManager->CurrentScopeID());
+    return context.make<ast::Expr>(visitCast(node), envManager->CurrentScopeID());
   case NodeType::ArrayCreation:
-    return std::make_shared<ast::Expr>(visitArrayCreation(node),
-                                       envManager->CurrentScopeID());
+    return context.make<ast::Expr>(visitArrayCreation(node),
+                                 envManager->CurrentScopeID());
   case NodeType::ClassCreation:
-    return std::make_shared<ast::Expr>(visitClassCreation(node),
-                                       envManager->CurrentScopeID());
+    return context.make<ast::Expr>(visitClassCreation(node),
+                                 envManager->CurrentScopeID());
   case NodeType::Literal:
-    return std::make_shared<ast::Expr>(
+    return context.make<ast::Expr>(
         std::vector<std::shared_ptr<ast::ExprNode>>{visitLiteral(node)},
         envManager->CurrentScopeID());
   case NodeType::Type:
-    return std::make_shared<ast::Expr>(
+    return context.make<ast::Expr>(
         std::vector<std::shared_ptr<ast::ExprNode>>{visitRegularType(node)},
         envManager->CurrentScopeID());
   case NodeType::ArrayType:
-    return std::make_shared<ast::Expr>(
+    return context.make<ast::Expr>(
         std::vector<std::shared_ptr<ast::ExprNode>>{visitArrayType(node)},
         envManager->CurrentScopeID());
   case NodeType::ArrayCastType:
-    return std::make_shared<ast::Expr>(
+    return context.make<ast::Expr>(
         std::vector<std::shared_ptr<ast::ExprNode>>{visitArrayType(node)},
         envManager->CurrentScopeID());
   case NodeType::Identifier: {
     std::vector<std::shared_ptr<ast::ExprNode>> exprNodes;
     auto name = visitIdentifier(node);
-    if (name == "this") {
-      exprNodes.push_back(std::make_shared<ast::ThisNode>());
+    if (name.view() == "this") {
+      exprNodes.push_back(context.make<ast::ThisNode>());
     } else {
-      exprNodes.push_back(std::make_shared<ast::MemberName>(name, node->loc));
+      exprNodes.push_back(context.make<ast::MemberName>(name, node->loc));
     }
-    return std::make_shared<ast::Expr>(exprNodes, envManager->CurrentScopeID());
+    return context.make<ast::Expr>(exprNodes, envManager->CurrentScopeID());
   }
   case NodeType::QualifiedName:
-    return std::make_shared<ast::Expr>(visitQualifiedIdentifierInExpr(node),
-                                       envManager->CurrentScopeID());
+    return context.make<ast::Expr>(visitQualifiedIdentifierInExpr(node),
+                                 envManager->CurrentScopeID());
   default:
     throw std::runtime_error("Invalid Expression");
   }
@@ -129,7 +128,7 @@ ParseTreeVisitor::visitExprNode(const NodePtr &node) {
   case 1:
     return visitExpression(node->child_at(0))->getExprNodes();
   case 2: { // Unary expression
-    auto right = visitExpression(node->child_at(1))->getExprNodes();
+    auto right = std::move(visitExpression(node->child_at(1))->getExprNodes());
 
     auto op = std::dynamic_pointer_cast<Operator>(node->child_at(0));
     if (!op) {
@@ -137,12 +136,12 @@ ParseTreeVisitor::visitExprNode(const NodePtr &node) {
           "Expected an operator node for unary expression");
     }
 
-    right.push_back(std::make_shared<ast::UnOp>(getUnOpType(op)));
+    right.push_back(context.make<ast::UnOp>(getUnOpType(op)));
     return right;
   }
   case 3: { // Binary expression
-    auto left = visitExpression(node->child_at(0))->getExprNodes();
-    auto right = visitExpression(node->child_at(2))->getExprNodes();
+    auto left = std::move(visitExpression(node->child_at(0))->getExprNodes());
+    auto right = std::move(visitExpression(node->child_at(2))->getExprNodes());
 
     auto op = std::dynamic_pointer_cast<Operator>(node->child_at(1));
     if (!op) {
@@ -151,7 +150,7 @@ ParseTreeVisitor::visitExprNode(const NodePtr &node) {
 
     left.insert(left.end(), std::make_move_iterator(right.begin()),
                 std::make_move_iterator(right.end()));
-    left.push_back(std::make_shared<ast::BinOp>(getBinOpType(op)));
+    left.push_back(context.make<ast::BinOp>(getBinOpType(op)));
     return left;
   }
   default:
@@ -165,15 +164,16 @@ ParseTreeVisitor::visitAssignment(const NodePtr &node) {
   check_num_children(node, 3, 3);
   std::vector<std::shared_ptr<ast::ExprNode>> ops;
 
-  auto lvalue = visitExpression(node->child_at(0))->getExprNodes();
+  auto lvalue = std::move(visitExpression(node->child_at(0))->getExprNodes());
   ops.insert(ops.end(), std::make_move_iterator(lvalue.begin()),
              std::make_move_iterator(lvalue.end()));
 
-  auto exprNodes = visitExpression(node->child_at(2))->getExprNodes();
+  auto exprNodes =
+      std::move(visitExpression(node->child_at(2))->getExprNodes());
   ops.insert(ops.end(), std::make_move_iterator(exprNodes.begin()),
              std::make_move_iterator(exprNodes.end()));
 
-  ops.push_back(std::make_shared<ast::Assignment>());
+  ops.push_back(context.make<ast::Assignment>());
 
   return ops;
 }
@@ -193,27 +193,28 @@ ParseTreeVisitor::visitMethodInvocation(const NodePtr &node) {
     ops.insert(ops.end(), std::make_move_iterator(args.begin()),
                std::make_move_iterator(args.end()));
 
-    ops.push_back(
-        std::make_shared<ast::MethodInvocation>(num_args + 1, qualifiedId));
+    ops.push_back(context.make<ast::MethodInvocation>(num_args + 1,
+                                                      std::move(qualifiedId)));
     return ops;
   }
   if (node->num_children() == 3) {
-    auto exprNodes = visitExpression(node->child_at(0))->getExprNodes();
+    auto exprNodes =
+        std::move(visitExpression(node->child_at(0))->getExprNodes());
     ops.insert(ops.end(), std::make_move_iterator(exprNodes.begin()),
                std::make_move_iterator(exprNodes.end()));
 
-    auto id = std::make_shared<ast::MethodName>(
+    auto id = context.make<ast::MethodName>(
         visitIdentifier(node->child_at(1)), node->loc);
     ops.push_back(id);
-    ops.push_back(std::make_shared<ast::FieldAccess>());
+    ops.push_back(context.make<ast::FieldAccess>());
 
     std::vector<std::shared_ptr<ast::ExprNode>> args;
     auto num_args = visitArgumentList(node->child_at(2), args);
     ops.insert(ops.end(), std::make_move_iterator(args.begin()),
                std::make_move_iterator(args.end()));
 
-    auto qid = std::vector<std::shared_ptr<ast::ExprNode>>{id};
-    ops.push_back(std::make_shared<ast::MethodInvocation>(num_args + 1, qid));
+    ops.push_back(context.make<ast::MethodInvocation>(
+        num_args + 1, std::vector<std::shared_ptr<ast::ExprNode>>{id}));
     return ops;
   }
 
@@ -226,13 +227,13 @@ ParseTreeVisitor::visitArrayAccess(const NodePtr &node) {
   check_node_type(node, NodeType::ArrayAccess);
   check_num_children(node, 2, 2);
   std::vector<std::shared_ptr<ast::ExprNode>> ops;
-  auto left = visitExpression(node->child_at(0))->getExprNodes();
-  auto right = visitExpression(node->child_at(1))->getExprNodes();
+  auto left = std::move(visitExpression(node->child_at(0))->getExprNodes());
+  auto right = std::move(visitExpression(node->child_at(1))->getExprNodes());
   ops.insert(ops.end(), std::make_move_iterator(left.begin()),
              std::make_move_iterator(left.end()));
   ops.insert(ops.end(), std::make_move_iterator(right.begin()),
              std::make_move_iterator(right.end()));
-  ops.push_back(std::make_shared<ast::ArrayAccess>());
+  ops.push_back(context.make<ast::ArrayAccess>());
   return ops;
 }
 
@@ -241,12 +242,12 @@ ParseTreeVisitor::visitFieldAccess(const NodePtr &node) {
   check_node_type(node, NodeType::FieldAccess);
   check_num_children(node, 2, 2);
   std::vector<std::shared_ptr<ast::ExprNode>> ops;
-  auto left = visitExpression(node->child_at(0))->getExprNodes();
+  auto left = std::move(visitExpression(node->child_at(0))->getExprNodes());
   ops.insert(ops.end(), std::make_move_iterator(left.begin()),
              std::make_move_iterator(left.end()));
-  ops.push_back(std::make_shared<ast::MemberName>(
+  ops.push_back(context.make<ast::MemberName>(
       visitIdentifier(node->child_at(1)), node->loc));
-  ops.push_back(std::make_shared<ast::FieldAccess>());
+  ops.push_back(context.make<ast::FieldAccess>());
   return ops;
 }
 
@@ -259,10 +260,10 @@ ParseTreeVisitor::visitCast(const NodePtr &node) {
   auto child = node->child_at(0);
   if (child->get_node_type() == NodeType::Type) {
     auto type = visitType(child);
-    ops.push_back(std::make_shared<ast::TypeNode>(type));
+    ops.push_back(context.make<ast::TypeNode>(type));
   } else if (child->get_node_type() == NodeType::QualifiedName) {
     auto type = visitReferenceType(child);
-    ops.push_back(std::make_shared<ast::TypeNode>(type));
+    ops.push_back(context.make<ast::TypeNode>(type));
   } else if (child->get_node_type() == NodeType::ArrayType ||
              child->get_node_type() == NodeType::ArrayCastType) {
     ops.push_back(visitArrayType(child));
@@ -270,9 +271,10 @@ ParseTreeVisitor::visitCast(const NodePtr &node) {
     throw std::runtime_error("Invalid Cast Expression");
   }
 
-  std::shared_ptr<ast::Cast> castOp = std::make_shared<ast::Cast>();
+  std::shared_ptr<ast::Cast> castOp = context.make<ast::Cast>();
 
-  auto exprNodes = visitExpression(node->child_at(1))->getExprNodes();
+  auto exprNodes =
+      std::move(visitExpression(node->child_at(1))->getExprNodes());
   if (exprNodes.size() == 1 &&
       std::dynamic_pointer_cast<ast::Literal>(exprNodes[0])) {
     castOp->setRhsLiteral(
@@ -281,7 +283,7 @@ ParseTreeVisitor::visitCast(const NodePtr &node) {
 
   ops.insert(ops.end(), std::make_move_iterator(exprNodes.begin()),
              std::make_move_iterator(exprNodes.end()));
-  ops.push_back(std::make_shared<ast::Cast>());
+  ops.push_back(context.make<ast::Cast>());
   return ops;
 }
 
@@ -291,18 +293,19 @@ ParseTreeVisitor::visitArrayCreation(const NodePtr &node) {
   check_num_children(node, 2, 2);
   std::vector<std::shared_ptr<ast::ExprNode>> ops;
   ops.push_back(visitArrayTypeInExpr(node->child_at(0)->child_at(0)));
-  auto exprNodes = visitExpression(node->child_at(1))->getExprNodes();
+  auto exprNodes =
+      std::move(visitExpression(node->child_at(1))->getExprNodes());
   ops.insert(ops.end(), std::make_move_iterator(exprNodes.begin()),
              std::make_move_iterator(exprNodes.end()));
-  ops.push_back(std::make_shared<ast::ArrayCreation>());
+  ops.push_back(context.make<ast::ArrayCreation>());
   return ops;
 }
 
-std::vector<std::string>
+std::vector<Symbol>
 ParseTreeVisitor::visitUnresolvedTypeExpr(const NodePtr &node) {
   check_node_type(node, NodeType::QualifiedName);
   check_num_children(node, 1, 2);
-  std::vector<std::string> ids;
+  std::vector<Symbol> ids;
 
   if (node->num_children() == 1) {
     ids.push_back(visitIdentifier(node->child_at(0)));
@@ -331,13 +334,13 @@ ParseTreeVisitor::visitClassCreation(const NodePtr &node) {
   // }
   // ops.push_back(exprNode);
   auto type = visitReferenceType(node->child_at(0));
-  ops.push_back(std::make_shared<ast::TypeNode>(type));
+  ops.push_back(context.make<ast::TypeNode>(type));
 
   std::vector<std::shared_ptr<ast::ExprNode>> args;
   auto num_args = visitArgumentList(node->child_at(1), args);
   ops.insert(ops.end(), std::make_move_iterator(args.begin()),
              std::make_move_iterator(args.end()));
-  ops.push_back(std::make_shared<ast::ClassCreation>(num_args + 1));
+  ops.push_back(context.make<ast::ClassCreation>(num_args + 1));
   return ops;
 }
 
@@ -350,12 +353,14 @@ int ParseTreeVisitor::visitArgumentList(
   int args = -1;
   if (node->num_children() == 1) {
     args = 1;
-    auto exprNodes = visitExpression(node->child_at(0))->getExprNodes();
+    auto exprNodes =
+        std::move(visitExpression(node->child_at(0))->getExprNodes());
     ops.insert(ops.end(), std::make_move_iterator(exprNodes.begin()),
                std::make_move_iterator(exprNodes.end()));
   } else if (node->num_children() == 2) {
     args = visitArgumentList(node->child_at(0), ops) + 1;
-    auto exprNodes = visitExpression(node->child_at(1))->getExprNodes();
+    auto exprNodes =
+        std::move(visitExpression(node->child_at(1))->getExprNodes());
     ops.insert(ops.end(), std::make_move_iterator(exprNodes.begin()),
                std::make_move_iterator(exprNodes.end()));
   }
@@ -373,14 +378,14 @@ ParseTreeVisitor::visitQualifiedIdentifierInExpr(const NodePtr &node,
   auto loc = node->loc;
   if (node->num_children() == 1) {
     ops.push_back(isMethod
-                      ? std::make_shared<ast::MethodName>(identifier, loc)
-                      : std::make_shared<ast::MemberName>(identifier, loc));
+                      ? context.make<ast::MethodName>(identifier, loc)
+                      : context.make<ast::MemberName>(identifier, loc));
   } else if (node->num_children() == 2) {
     ops = visitQualifiedIdentifierInExpr(node->child_at(0));
     ops.push_back(isMethod
-                      ? std::make_shared<ast::MethodName>(identifier, loc)
-                      : std::make_shared<ast::MemberName>(identifier, loc));
-    ops.push_back(std::make_shared<ast::FieldAccess>());
+                      ? context.make<ast::MethodName>(identifier, loc)
+                      : context.make<ast::MemberName>(identifier, loc));
+    ops.push_back(context.make<ast::FieldAccess>());
   }
   return ops;
 }
@@ -394,7 +399,7 @@ ParseTreeVisitor::visitLiteral(const NodePtr &node) {
     throw std::runtime_error("Expected literal node");
   }
   std::vector<std::shared_ptr<ast::ExprNode>> exprNodes;
-  exprNodes.push_back(std::make_shared<ast::Literal>(
+  exprNodes.push_back(context.make<ast::Literal>(
       lit, envManager->BuildBasicType(lit->getType())));
   return exprNodes;
 }
@@ -405,10 +410,9 @@ ParseTreeVisitor::visitBasicType(const NodePtr &node) {
   check_num_children(node, 1, 1);
   if (auto basicType =
           std::dynamic_pointer_cast<BasicType>(node->child_at(0))) {
-    return std::make_shared<ast::BasicType>(basicType->getType());
+    return context.make<ast::BasicType>(basicType->getType());
   } else if (node->child_at(0)->get_node_type() == NodeType::QualifiedName) {
-    return std::make_shared<ast::TypeNode>(
-        visitReferenceType(node->child_at(0)));
+    return context.make<ast::TypeNode>(visitReferenceType(node->child_at(0)));
   }
   throw std::runtime_error("Expected a BasicType or QualifiedName node");
 }
@@ -416,11 +420,11 @@ ParseTreeVisitor::visitBasicType(const NodePtr &node) {
 std::shared_ptr<ast::ExprNode>
 ParseTreeVisitor::visitArrayTypeInExpr(const NodePtr &node) {
   if (auto basicType = std::dynamic_pointer_cast<BasicType>(node)) {
-    return std::make_shared<ast::TypeNode>(std::make_shared<ast::ArrayType>(
-        std::make_shared<ast::BasicType>(basicType->getType())));
+    return context.make<ast::TypeNode>(context.make<ast::ArrayType>(
+        context.make<ast::BasicType>(basicType->getType())));
   } else if (node->get_node_type() == NodeType::QualifiedName) {
-    return std::make_shared<ast::TypeNode>(
-        std::make_shared<ast::ArrayType>(visitReferenceType(node)));
+    return context.make<ast::TypeNode>(
+        context.make<ast::ArrayType>(visitReferenceType(node)));
   } else {
     throw std::runtime_error(
         "Expected a BasicType or QualifiedName node for ArrayTypeInExpr");
@@ -439,7 +443,7 @@ ParseTreeVisitor::visitArrayType(const NodePtr &node) {
 
 std::shared_ptr<ast::ExprNode>
 ParseTreeVisitor::visitRegularType(const NodePtr &node) {
-  return std::make_shared<ast::TypeNode>(visitType(node));
+  return context.make<ast::TypeNode>(visitType(node));
 }
 
 } // namespace parsetree
\ No newline at end of file
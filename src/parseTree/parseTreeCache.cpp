@@ -0,0 +1,215 @@
+#include "parseTree/parseTreeCache.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace parsetree {
+
+namespace {
+
+constexpr char MAGIC[8] = {'J', 'O', 'O', 'S', 'P', 'T', 'C', '\0'};
+
+template <typename T> void writeRaw(std::string &out, T value) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+void writeString(std::string &out, std::string_view str) {
+  writeRaw<uint32_t>(out, str.size());
+  out.append(str);
+}
+
+template <typename T> T readRaw(std::string_view &in) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  if (in.size() < sizeof(T))
+    throw std::runtime_error("Parse tree cache is truncated");
+  T value;
+  std::memcpy(&value, in.data(), sizeof(T));
+  in.remove_prefix(sizeof(T));
+  return value;
+}
+
+std::string readString(std::string_view &in) {
+  auto size = readRaw<uint32_t>(in);
+  if (in.size() < size)
+    throw std::runtime_error("Parse tree cache is truncated");
+  std::string str{in.substr(0, size)};
+  in.remove_prefix(size);
+  return str;
+}
+
+} // namespace
+
+uint64_t ParseTreeCache::hashContent(std::string_view content) {
+  // FNV-1a
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (unsigned char c : content) {
+    hash ^= c;
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+void ParseTreeCache::writeNode(std::string &out,
+                               const std::shared_ptr<Node> &node) {
+  if (!node) {
+    writeRaw<uint8_t>(out, 0);
+    return;
+  }
+  writeRaw<uint8_t>(out, 1);
+  writeRaw<uint8_t>(out, static_cast<uint8_t>(node->get_node_type()));
+  writeRaw<uint32_t>(out, node->loc.offset);
+  writeRaw<uint32_t>(out, node->loc.length);
+
+  switch (node->get_node_type()) {
+  case Node::Type::Literal: {
+    auto lit = std::static_pointer_cast<Literal>(node);
+    writeRaw<uint8_t>(out, static_cast<uint8_t>(lit->getType()));
+    writeRaw<uint8_t>(out, lit->isNegativeVal());
+    writeString(out, lit->getValue());
+    break;
+  }
+  case Node::Type::Identifier:
+    writeString(out, std::static_pointer_cast<Identifier>(node)->get_name());
+    break;
+  case Node::Type::Operator:
+    writeRaw<uint8_t>(out, static_cast<uint8_t>(
+                               std::static_pointer_cast<Operator>(node)
+                                   ->getType()));
+    break;
+  case Node::Type::Modifier:
+    writeRaw<uint8_t>(out, static_cast<uint8_t>(
+                               std::static_pointer_cast<Modifier>(node)
+                                   ->get_type()));
+    break;
+  case Node::Type::BasicType:
+    writeRaw<uint8_t>(out, static_cast<uint8_t>(
+                               std::static_pointer_cast<BasicType>(node)
+                                   ->getType()));
+    break;
+  default:
+    writeRaw<uint32_t>(out, node->num_children());
+    for (size_t i = 0; i < node->num_children(); ++i) {
+      writeNode(out, node->child_at(i));
+    }
+    break;
+  }
+}
+
+std::shared_ptr<Node> ParseTreeCache::readNode(std::string_view &in,
+                                               int fileID) {
+  if (readRaw<uint8_t>(in) == 0)
+    return nullptr;
+
+  auto type = static_cast<Node::Type>(readRaw<uint8_t>(in));
+  source::SourceRange loc;
+  loc.fileID = fileID;
+  loc.offset = readRaw<uint32_t>(in);
+  loc.length = readRaw<uint32_t>(in);
+
+  std::shared_ptr<Node> node;
+  switch (type) {
+  case Node::Type::Literal: {
+    auto litType = static_cast<Literal::Type>(readRaw<uint8_t>(in));
+    bool negative = readRaw<uint8_t>(in);
+    auto lit = std::make_shared<Literal>(litType, readString(in).c_str());
+    if (negative)
+      lit->setNegative();
+    node = lit;
+    break;
+  }
+  case Node::Type::Identifier:
+    node = std::make_shared<Identifier>(readString(in));
+    break;
+  case Node::Type::Operator:
+    node = std::make_shared<Operator>(
+        static_cast<Operator::Type>(readRaw<uint8_t>(in)));
+    break;
+  case Node::Type::Modifier:
+    node = std::make_shared<Modifier>(
+        static_cast<Modifier::Type>(readRaw<uint8_t>(in)));
+    break;
+  case Node::Type::BasicType:
+    node = std::make_shared<BasicType>(
+        static_cast<BasicType::Type>(readRaw<uint8_t>(in)));
+    break;
+  default: {
+    auto numChildren = readRaw<uint32_t>(in);
+    std::vector<std::shared_ptr<Node>> children;
+    children.reserve(numChildren);
+    for (uint32_t i = 0; i < numChildren; ++i) {
+      children.push_back(readNode(in, fileID));
+    }
+    node = std::make_shared<Node>(loc, type, std::move(children));
+    break;
+  }
+  }
+  node->loc = loc;
+  return node;
+}
+
+bool ParseTreeCache::load(const std::string &cachePath) {
+  entries.clear();
+  std::ifstream file(cachePath, std::ios::binary);
+  if (!file.is_open())
+    return false;
+  const std::string content((std::istreambuf_iterator<char>(file)),
+                            std::istreambuf_iterator<char>());
+
+  try {
+    std::string_view in{content};
+    if (in.size() < sizeof(MAGIC) ||
+        std::memcmp(in.data(), MAGIC, sizeof(MAGIC)) != 0)
+      return false;
+    in.remove_prefix(sizeof(MAGIC));
+    if (readRaw<uint32_t>(in) != VERSION)
+      return false;
+
+    auto numEntries = readRaw<uint32_t>(in);
+    for (uint32_t i = 0; i < numEntries; ++i) {
+      auto path = readString(in);
+      auto hash = readRaw<uint64_t>(in);
+      entries[path] = Entry{hash, readString(in)};
+    }
+  } catch (const std::runtime_error &) {
+    entries.clear();
+    return false;
+  }
+  return true;
+}
+
+void ParseTreeCache::save(const std::string &cachePath) const {
+  std::string out{MAGIC, sizeof(MAGIC)};
+  writeRaw<uint32_t>(out, VERSION);
+  writeRaw<uint32_t>(out, entries.size());
+  for (auto &[path, entry] : entries) {
+    writeString(out, path);
+    writeRaw<uint64_t>(out, entry.hash);
+    writeString(out, entry.data);
+  }
+
+  std::ofstream file(cachePath, std::ios::binary | std::ios::trunc);
+  if (!file.is_open())
+    throw std::runtime_error("Could not open parse tree cache " + cachePath +
+                             " for writing");
+  file.write(out.data(), out.size());
+}
+
+std::shared_ptr<Node> ParseTreeCache::lookup(const std::string &filePath,
+                                             uint64_t hash, int fileID) const {
+  auto it = entries.find(filePath);
+  if (it == entries.end() || it->second.hash != hash)
+    return nullptr;
+  std::string_view in{it->second.data};
+  return readNode(in, fileID);
+}
+
+void ParseTreeCache::insert(const std::string &filePath, uint64_t hash,
+                            std::shared_ptr<Node> tree) {
+  std::string data;
+  writeNode(data, tree);
+  entries[filePath] = Entry{hash, std::move(data)};
+}
+
+} // namespace parsetree
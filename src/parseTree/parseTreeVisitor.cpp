@@ -43,7 +43,8 @@ ParseTreeVisitor::visitProgramDecl(const NodePtr &node) {
   }
 
   // Return the constructed AST node
-  return envManager->BuildProgramDecl(package, imports, body_ast_node);
+  return envManager->BuildProgramDecl(package, std::move(imports),
+                                      body_ast_node);
 }
 
 std::shared_ptr<ast::ReferenceType>
@@ -64,9 +65,9 @@ ParseTreeVisitor::visit<NodeType::ImportDeclList>(const NodePtr &node) {
 
   switch (node->get_node_type()) {
   case NodeType::SingleImportDecl:
-    return std::make_shared<ast::ImportDecl>(id, /* hasStar */ false);
+    return context.make<ast::ImportDecl>(id, /* hasStar */ false);
   case NodeType::MultiImportDecl:
-    return std::make_shared<ast::ImportDecl>(id, /* hasStar */ true);
+    return context.make<ast::ImportDecl>(id, /* hasStar */ true);
   default:
     throw std::runtime_error(
         "visit<ImportDeclList> called on an invalid node type");
@@ -83,7 +84,7 @@ ParseTreeVisitor::visitClassDecl(const NodePtr &node) {
   envManager->ResetFieldScope();
 
   // Visit the modifiers identifier etc
-  std::shared_ptr<ast::Modifiers> modifiers = std::make_shared<ast::Modifiers>(
+  std::shared_ptr<ast::Modifiers> modifiers = context.make<ast::Modifiers>(
       visitModifierList(node->child_at(0), ast::Modifiers{}));
   auto name = visitIdentifier(node->child_at(1));
   auto super = visitSuper(node->child_at(2));
@@ -99,8 +100,9 @@ ParseTreeVisitor::visitClassDecl(const NodePtr &node) {
                    true>(node->child_at(4), classBodyDecls);
 
   // Return the constructed AST node
-  return envManager->BuildClassDecl(modifiers, name, super, interfaces,
-                                    classBodyDecls);
+  return envManager->BuildClassDecl(modifiers, std::move(name), super,
+                                    std::move(interfaces),
+                                    std::move(classBodyDecls));
 }
 
 std::shared_ptr<ast::ReferenceType>
@@ -143,7 +145,7 @@ ParseTreeVisitor::visitFieldDecl(const NodePtr &node) {
   check_num_children(node, 3, 3);
 
   std::shared_ptr<ast::Modifiers> modifiers =
-      std::make_shared<ast::Modifiers>(visitModifierList(node->child_at(0)));
+      context.make<ast::Modifiers>(visitModifierList(node->child_at(0)));
 
   auto decl = visitLocalDecl(node->child_at(1), node->child_at(2));
   if (decl.init)
@@ -163,11 +165,11 @@ ParseTreeVisitor::visitMethodDecl(const NodePtr &node) {
 
   // Visit the modifiers
   std::shared_ptr<ast::Modifiers> modifiers =
-      std::make_shared<ast::Modifiers>(visitModifierList(node->child_at(0)));
+      context.make<ast::Modifiers>(visitModifierList(node->child_at(0)));
   // type could be void
   std::shared_ptr<ast::Type> type =
       (node->num_children() == 5) ? visitType(node->child_at(1)) : nullptr;
-  std::string name = visitIdentifier(node->child_at(type ? 2 : 1));
+  auto name = visitIdentifier(node->child_at(type ? 2 : 1));
 
   std::vector<std::shared_ptr<ast::VarDecl>> params;
   // visit params
@@ -179,8 +181,8 @@ ParseTreeVisitor::visitMethodDecl(const NodePtr &node) {
       node->child_at(type ? 4 : 3) ? visitBlock(node->child_at(type ? 4 : 3))
                                    : nullptr;
 
-  return envManager->BuildMethodDecl(modifiers, name, type, params, false, body,
-                                     node->loc);
+  return envManager->BuildMethodDecl(modifiers, std::move(name), type,
+                                     std::move(params), false, body, node->loc);
 }
 
 std::shared_ptr<ast::MethodDecl>
@@ -193,7 +195,7 @@ ParseTreeVisitor::visitConstructorDecl(const NodePtr &node) {
 
   // need to visit modifier, identifier and parameters
   std::shared_ptr<ast::Modifiers> modifiers =
-      std::make_shared<ast::Modifiers>(visitModifierList(node->child_at(0)));
+      context.make<ast::Modifiers>(visitModifierList(node->child_at(0)));
   auto name = visitIdentifier(node->child_at(1));
 
   std::vector<std::shared_ptr<ast::VarDecl>> params;
@@ -204,8 +206,8 @@ ParseTreeVisitor::visitConstructorDecl(const NodePtr &node) {
   std::shared_ptr<ast::Block> body =
       node->child_at(3) ? visitBlock(node->child_at(3)) : nullptr;
 
-  return envManager->BuildMethodDecl(modifiers, name, nullptr, params, true,
-                                     body, node->loc);
+  return envManager->BuildMethodDecl(modifiers, std::move(name), nullptr,
+                                     std::move(params), true, body, node->loc);
 }
 
 template <>
@@ -230,7 +232,7 @@ ParseTreeVisitor::visitInterfaceDecl(const NodePtr &node) {
   check_num_children(node, 4, 4);
   envManager->ResetFieldScope();
 
-  std::shared_ptr<ast::Modifiers> modifiers = std::make_shared<ast::Modifiers>(
+  std::shared_ptr<ast::Modifiers> modifiers = context.make<ast::Modifiers>(
       visitModifierList(node->child_at(0), ast::Modifiers{}));
   auto name = visitIdentifier(node->child_at(1));
 
@@ -243,8 +245,9 @@ ParseTreeVisitor::visitInterfaceDecl(const NodePtr &node) {
   visitListPattern<NodeType::InterfaceBodyDeclList, std::shared_ptr<ast::Decl>,
                    true>(node->child_at(3), interfaceBodyDecls);
 
-  return envManager->BuildInterfaceDecl(modifiers, name, extends,
-                                        interfaceBodyDecls);
+  return envManager->BuildInterfaceDecl(modifiers, std::move(name),
+                                        std::move(extends),
+                                        std::move(interfaceBodyDecls));
 }
 
 // Abstract Method Declaration
@@ -258,7 +261,7 @@ ParseTreeVisitor::visitAbstractMethodDecl(const NodePtr &node) {
   envManager->ClearLocalScope();
 
   std::shared_ptr<ast::Modifiers> modifiers =
-      std::make_shared<ast::Modifiers>(visitModifierList(node->child_at(0)));
+      context.make<ast::Modifiers>(visitModifierList(node->child_at(0)));
   // type could be void
   auto type =
       (node->num_children() == 4) ? visitType(node->child_at(1)) : nullptr;
@@ -273,8 +276,9 @@ ParseTreeVisitor::visitAbstractMethodDecl(const NodePtr &node) {
     modifiers->setAbstract();
   }
 
-  return envManager->BuildMethodDecl(modifiers, name, type, params, false,
-                                     nullptr, node->loc);
+  return envManager->BuildMethodDecl(modifiers, std::move(name), type,
+                                     std::move(params), false, nullptr,
+                                     node->loc);
 }
 
 template <>
@@ -319,7 +323,7 @@ ParseTreeVisitor::visitStatement(const NodePtr &node) {
     return visitLocalDeclStatement(node);
   case NodeType::Statement:
     // throw std::runtime_error("Got Statement");
-    return std::make_shared<ast::NullStmt>();
+    return context.make<ast::NullStmt>();
   default:
     throw std::runtime_error("Invalid Statement");
   }
@@ -333,7 +337,7 @@ std::shared_ptr<ast::Block> ParseTreeVisitor::visitBlock(const NodePtr &node) {
   if (node->child_at(0) == nullptr) {
     // this case is when public abstract int foo() {}
     // so it should consider an empty block
-    return std::make_shared<ast::Block>();
+    return context.make<ast::Block>();
   }
   std::vector<std::shared_ptr<ast::Stmt>> statements;
 
@@ -341,7 +345,7 @@ std::shared_ptr<ast::Block> ParseTreeVisitor::visitBlock(const NodePtr &node) {
   size_t scope = envManager->EnterNewScope();
   visitStatementList(node->child_at(0), statements);
   envManager->ExitScope(scope);
-  return std::make_shared<ast::Block>(statements);
+  return context.make<ast::Block>(statements);
 }
 
 std::shared_ptr<ast::ReturnStmt>
@@ -350,10 +354,9 @@ ParseTreeVisitor::visitReturnStatement(const NodePtr &node) {
   check_node_type(node, NodeType::ReturnStatement);
   check_num_children(node, 0, 1);
   if (node->child_at(0) == nullptr) {
-    return std::make_shared<ast::ReturnStmt>();
+    return context.make<ast::ReturnStmt>();
   } else {
-    return std::make_shared<ast::ReturnStmt>(
-        visitExpression(node->child_at(0)));
+    return context.make<ast::ReturnStmt>(visitExpression(node->child_at(0)));
   }
 }
 
@@ -371,7 +374,7 @@ ParseTreeVisitor::visitIfStatement(const NodePtr &node) {
   auto stmt = visitStatement(node->child_at(1));
   envManager->ExitScope(scope);
 
-  return std::make_shared<ast::IfStmt>(
+  return context.make<ast::IfStmt>(
       visitExpression(node->child_at(0)), stmt,
       node->num_children() == 3 ? visitStatement(node->child_at(2)) : nullptr);
 }
@@ -390,8 +393,8 @@ ParseTreeVisitor::visitWhileStatement(const NodePtr &node) {
   auto stmt = visitStatement(node->child_at(1));
   envManager->ExitScope(scope);
 
-  return std::make_shared<ast::WhileStmt>(visitExpression(node->child_at(0)),
-                                          stmt);
+  return context.make<ast::WhileStmt>(visitExpression(node->child_at(0)),
+                                      stmt);
 }
 
 std::shared_ptr<ast::ForStmt>
@@ -434,7 +437,7 @@ ParseTreeVisitor::visitForStatement(const NodePtr &node) {
   body = visitStatement(node->child_at(3));
   envManager->ExitScope(scope);
 
-  return std::make_shared<ast::ForStmt>(init, condition, update, body);
+  return context.make<ast::ForStmt>(init, condition, update, body);
 }
 
 std::shared_ptr<ast::ExpressionStmt>
@@ -445,8 +448,7 @@ ParseTreeVisitor::visitExprStatement(const NodePtr &node) {
   if (!node->child_at(0)) {
     throw std::runtime_error("Invalid StatementExpr");
   }
-  return std::make_shared<ast::ExpressionStmt>(
-      visitExpression(node->child_at(0)));
+  return context.make<ast::ExpressionStmt>(visitExpression(node->child_at(0)));
 }
 
 ParseTreeVisitor::VariableDecl
@@ -502,9 +504,9 @@ std::shared_ptr<ast::UnresolvedType> ParseTreeVisitor::visitReferenceType(
   return ast_node;
 }
 
-std::string ParseTreeVisitor::visitIdentifier(const NodePtr &node) {
+Symbol ParseTreeVisitor::visitIdentifier(const NodePtr &node) {
   check_node_type(node, NodeType::Identifier);
-  return std::dynamic_pointer_cast<Identifier>(node)->get_name();
+  return std::dynamic_pointer_cast<Identifier>(node)->get_symbol();
 }
 
 ast::Modifiers ParseTreeVisitor::visitModifierList(const NodePtr &node,
@@ -13,6 +13,16 @@
     #define YYMAXDEPTH 100000
     #define YYINITDEPTH 100000
 
+    // Locations are byte ranges, not the line/column pairs bison assumes
+    #define YYLLOC_DEFAULT(Current, Rhs, N)                                 \
+        do {                                                               \
+            if (N)                                                         \
+                (Current) = source::SourceRange::span(YYRHSLOC(Rhs, 1),    \
+                                                      YYRHSLOC(Rhs, N));   \
+            else                                                           \
+                (Current) = source::SourceRange::after(YYRHSLOC(Rhs, 0));  \
+        } while (0)
+
     extern int yylex(YYSTYPE*, YYLTYPE*, myFlexLexer&);
     static void yyerror(YYLTYPE*, YYSTYPE*, myFlexLexer&, const char*);
 }
@@ -588,7 +598,8 @@ cast_expr:
             $$ = lexer.make_node(@$, NodeType::Cast, std::move($2), std::move($4));
         } else {
             std::cerr << "Cast expression is not valid" << std::endl;
-            $$ = lexer.make_corrupted("some cast expression");
+            lexer.set_parse_error("some cast expression");
+            YYABORT;
         }
     }
 ;
@@ -638,7 +649,8 @@ field_access_expr:
         int numChildren = $1->num_children();
         if(isExpression && numChildren == 1 && $1->child_at(0)->get_node_type() == parsetree::Node::Type::QualifiedName) {
             std::cerr << "Invalid expression for field access" << std::endl;
-            $$ = lexer.make_corrupted("some field access expression");
+            lexer.set_parse_error("some field access expression");
+            YYABORT;
         } else {
             $$ = lexer.make_node(@$, NodeType::FieldAccess, std::move($1), std::move($3));
         }
@@ -698,6 +710,6 @@ std::string parser_resolve_token(int yysymbol) {
 
 static void yyerror(YYLTYPE* loc, YYSTYPE* ret, myFlexLexer& lexer, const char* s) {
     (void) ret;
-    std::cerr << "Parsing error! : " << s << std::endl;
-    std::cerr << loc->fileID << " " << loc->first_line << ":" << loc->first_column << " - " << loc->last_line << ":" << loc->last_column << "\n";
+    // printed by the driver, which can turn the offsets into lines
+    lexer.set_syntax_error(s, *loc);
 }
@@ -70,13 +70,13 @@ void ASTValidator::validateMethod(
           std::dynamic_pointer_cast<parsetree::ast::ClassDecl>(parent);
       if (parentClass) {
         int validSuperClass = 0;
-        for (auto superRef : parentClass->getSuperClasses()) {
+        for (const auto &superRef : parentClass->getSuperClasses()) {
           if (superRef)
             validSuperClass++;
         }
         bool needCheck = false;
         std::vector<std::shared_ptr<parsetree::ast::MethodDecl>> validSupers;
-        for (auto superRef : parentClass->getSuperClasses()) {
+        for (const auto &superRef : parentClass->getSuperClasses()) {
           if (!superRef)
             continue;
           if (!(superRef->isResolved())) {
@@ -170,11 +170,11 @@ void ASTValidator::validateStmt(std::shared_ptr<parsetree::ast::Stmt> stmt) {
           "while condition expression must be yield a boolean");
     }
   }
-  for (auto child : stmt->getChildren()) {
+  stmt->forEachChild([&](const auto &child) {
     if (auto stmt = std::dynamic_pointer_cast<parsetree::ast::Stmt>(child)) {
       validateStmt(stmt);
     }
-  }
+  });
 }
 
 void ASTValidator::validateReturnStmt(
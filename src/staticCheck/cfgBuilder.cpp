@@ -9,9 +9,9 @@ using EvalType = std::variant<bool, u_int32_t, std::nullptr_t>;
 // TODO: may need to handle char/string literals as well?
 static EvalType
 evaluateBoolConstantExpr(std::shared_ptr<parsetree::ast::Expr> expr) {
-  auto exprNodes = expr->getExprNodes();
+  const auto &exprNodes = expr->getExprNodes();
   std::stack<EvalType> st;
-  for (auto exprNode : exprNodes) {
+  for (const auto &exprNode : exprNodes) {
     if (auto binOp =
             std::dynamic_pointer_cast<parsetree::ast::BinOp>(exprNode)) {
       auto binOpType = binOp->getOp();
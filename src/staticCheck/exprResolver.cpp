@@ -1,4 +1,5 @@
 #include "staticCheck/exprResolver.hpp"
+#include "utils/timeReport.hpp"
 #include <string>
 
 namespace static_check {
@@ -10,53 +11,13 @@ using exprResolveType =
 using previousType =
     std::variant<std::shared_ptr<ExprNameLinked>, ExprNodeList>;
 
-// Taken from HierarchyCheck
-bool isClass(std::shared_ptr<parsetree::ast::AstNode> decl) {
-  return !!std::dynamic_pointer_cast<parsetree::ast::ClassDecl>(decl);
-}
-
-// Taken from HierarchyCheck
-bool isInterface(std::shared_ptr<parsetree::ast::AstNode> decl) {
-  return !!std::dynamic_pointer_cast<parsetree::ast::InterfaceDecl>(decl);
-}
-
-bool isSuperClass(std::shared_ptr<parsetree::ast::AstNode> super,
-                  std::shared_ptr<parsetree::ast::AstNode> child) {
-  if (!child || !super) {
-    return false;
-  }
-  if (!isClass(child)) {
-    return false;
-  }
-  if (!isClass(super)) {
-    return false;
-  }
-  auto childDecl = std::dynamic_pointer_cast<parsetree::ast::ClassDecl>(child);
-  auto superDecl = std::dynamic_pointer_cast<parsetree::ast::ClassDecl>(super);
-
-  for (auto &superClass : childDecl->getSuperClasses()) {
-    if (!superClass || !superClass->getResolvedDecl().getAstNode())
-      continue;
-
-    // Cast to class
-    auto superClassDecl = std::dynamic_pointer_cast<parsetree::ast::ClassDecl>(
-        superClass->getResolvedDecl().getAstNode());
-
-    if (superClassDecl == superDecl)
-      return true;
-
-    if (isSuperClass(super, std::dynamic_pointer_cast<parsetree::ast::AstNode>(
-                                superClassDecl)))
-      return true;
-  }
-  return false;
-}
-
 void ExprResolver::resolve() {
   for (auto ast : astManager->getASTs()) {
     auto program = std::dynamic_pointer_cast<parsetree::ast::ProgramDecl>(ast);
     if (!program)
       throw std::runtime_error("Not AST");
+    utils::TimeReport::Scope unit{"expr resolution",
+                                  program->getBody()->asDecl()->getName()};
     typeLinker->setCurrentProgram(program);
     resolveAST(ast);
     // std::cout << "-------- an AST resolved\n";
@@ -73,7 +34,7 @@ void ExprResolver::resolveAST(std::shared_ptr<parsetree::ast::AstNode> node) {
   }
 
   staticState.isInstFieldInitializer = false;
-  staticState.fieldScope = nullptr;
+  staticState.fieldScope = {};
 
   if (auto programDecl =
           std::dynamic_pointer_cast<parsetree::ast::ProgramDecl>(node)) {
@@ -117,19 +78,17 @@ void ExprResolver::resolveAST(std::shared_ptr<parsetree::ast::AstNode> node) {
                  std::dynamic_pointer_cast<parsetree::ast::Expr>(node)) {
     evaluate(expr);
   } else {
-    for (const auto &child : node->getChildren()) {
-      if (!child)
-        continue;
-      resolveAST(child);
-    }
+    node->forEachChild([&](const auto &child) {
+      if (child)
+        resolveAST(child);
+    });
   }
 }
 
 std::shared_ptr<parsetree::ast::Type>
 ExprResolver::evaluate(std::shared_ptr<parsetree::ast::Expr> expr) {
   currentScope = expr->getScope();
-  auto nodes = expr->getExprNodes();
-  auto ret = evaluateList(nodes);
+  auto ret = evaluateList(expr->getExprNodes());
   auto resolved = resolveExprNode(ret);
 
   // FIXME: rm this when type linker works
@@ -154,8 +113,8 @@ ExprResolver::evaluate(std::shared_ptr<parsetree::ast::Expr> expr) {
       }
     }
   }
-  expr->setExprNodes(resolved);
-  auto type = typeResolver->EvalList(resolved);
+  expr->setExprNodes(std::move(resolved));
+  auto type = typeResolver->EvalList(expr->getExprNodes());
   staticResolver->evaluate(expr, staticState);
   return type;
 }
@@ -201,9 +160,7 @@ ExprResolver::resolveExprNode(const exprResolveType node) {
       if (thisNode->isTypeResolved()) {
         thisNode->setResolvedDecl(currentDecl);
       } else {
-        auto refType =
-            std::make_shared<parsetree::ast::ReferenceType>(currentDecl);
-        refType->setResolvedDecl(Decl{currentDecl});
+        auto refType = astManager->types.getReferenceType(currentDecl);
         if (!refType->getResolvedDecl().getAstNode())
           throw std::runtime_error("resolved decl not sets");
         thisNode->resolveDeclAndType(currentDecl, refType);
@@ -252,20 +209,22 @@ ExprResolver::resolveExprNode(const exprResolveType node) {
  */
 std::shared_ptr<parsetree::ast::Decl>
 ExprResolver::lookupNamedDecl(std::shared_ptr<parsetree::ast::CodeBody> ctx,
-                              std::string name, const source::SourceRange loc) {
+                              parsetree::Symbol name,
+                              const source::SourceRange loc) {
+  // every candidate below is a pointer compare
   auto condition = [loc, name,
                     this](std::shared_ptr<parsetree::ast::Decl> decl) {
     if (auto typedDecl =
             std::dynamic_pointer_cast<parsetree::ast::VarDecl>(decl);
         typedDecl) {
-      bool sameName = decl->getName() == name;
+      bool sameName = decl->getSymbol() == name;
       bool sameContext = decl->getParent() == currentContext;
       bool checkScope =
           (!(std::dynamic_pointer_cast<parsetree::ast::FieldDecl>(decl)) &&
            currentScope);
       bool scopeVisible = true;
       if (sameContext && checkScope) {
-        scopeVisible = currentScope->canView(typedDecl->getScope());
+        scopeVisible = currentScope.canView(typedDecl->getScope());
         // std::cout << "checking scope visibility for " << name << ",
         // currentScope: " << currentScope->toString(); std::cout << ",
         // typedDecl: " << typedDecl->getName() << " ";
@@ -302,9 +261,9 @@ ExprResolver::lookupNamedDecl(std::shared_ptr<parsetree::ast::CodeBody> ctx,
 
     // Search in the inherit set
     std::shared_ptr<parsetree::ast::Decl> result = nullptr;
-    // TODO: this recomputes inherited field every time...
-    auto inheritedFields = hierarchyChecker->getInheritedFields(classDecl);
-    for (const auto decl : inheritedFields) {
+    const auto &inheritedFields =
+        hierarchyChecker->getInheritedFields(classDecl);
+    for (const auto &decl : inheritedFields) {
       if (condition(decl.second)) {
         if (result)
           return nullptr; // Ambiguous case
@@ -345,7 +304,8 @@ std::shared_ptr<parsetree::ast::Decl>
 ExprResolver::reclassifyDecl(std::shared_ptr<parsetree::ast::CodeBody> ctx,
                              std::shared_ptr<ExprNameLinked> node) {
   auto astNode = node->getNode();
-  if (auto decl = lookupNamedDecl(ctx, astNode->getName(), astNode->getLoc())) {
+  if (auto decl =
+          lookupNamedDecl(ctx, astNode->getSymbol(), astNode->getLoc())) {
     if (auto fieldDecl =
             std::dynamic_pointer_cast<parsetree::ast::FieldDecl>(decl)) {
       node->setValueType(ExprNameLinked::ValueType::ExpressionName);
@@ -405,17 +365,11 @@ ExprResolver::resolveMemberName(std::shared_ptr<ExprNameLinked> expr) {
   }
 
   // Try to find an import matching the expression node's name
-  auto &context = typeLinker->getContext(currentProgram);
-  auto import = context.find(expr->getNode()->getName()) != context.end()
-                    ? context[expr->getNode()->getName()]
-                    : nullptr;
+  auto import = typeLinker->resolveSimpleName(expr->getNode()->getSymbol(),
+                                              currentProgram);
 
   // not found
   if (std::holds_alternative<nullptr_t>(import)) {
-    for (auto pair : context) {
-      std::cout << pair.first << " ";
-    }
-    std::cout << std::endl;
     throw std::runtime_error("No import for " + expr->getNode()->getName());
   }
 
@@ -430,8 +384,7 @@ ExprResolver::resolveMemberName(std::shared_ptr<ExprNameLinked> expr) {
 
     // Resolve the declaration as a reference type if not already resolved.
     if (!expr->getNode()->isTypeResolved()) {
-      auto refType = std::make_shared<parsetree::ast::ReferenceType>(declNode);
-      refType->setResolvedDecl(Decl{declNode});
+      auto refType = astManager->types.getReferenceType(declNode);
       expr->getNode()->resolveDeclAndType(declNode, refType);
     } else if (!expr->getNode()->isDeclResolved()) {
       expr->getNode()->setResolvedDecl(declNode);
@@ -649,7 +602,7 @@ ExprResolver::evalFieldAccess(std::shared_ptr<parsetree::ast::FieldAccess> &op,
     } else if (auto memberName =
                    std::dynamic_pointer_cast<parsetree::ast::MemberName>(
                        lhsNode)) {
-      if (memberName->getName() == currentClass->getName()) {
+      if (memberName->getSymbol() == currentClass->getSymbol()) {
         fieldNode->setAccessedByThis();
       }
     }
@@ -761,7 +714,7 @@ exprResolveType ExprResolver::evalMethodInvocation(
   // Begin resolution of the method call
   auto ctx = getMethodParent(unresolved);
   auto methodDecl =
-      resolveMethodOverload(ctx, unresolved->getNode()->getName(), argTypes,
+      resolveMethodOverload(ctx, unresolved->getNode()->getSymbol(), argTypes,
                             unresolved->getNode()->getLoc(), false);
 
   // Ensure the method is accessible from the current context.
@@ -898,7 +851,8 @@ ExprResolver::evalNewObject(std::shared_ptr<parsetree::ast::ClassCreation> &op,
   // Begin resolution of the method call
   auto loc = source::SourceRange();
   loc.fileID = INT_MAX;
-  auto methodDecl = resolveMethodOverload(ctx, "", argType, loc, true);
+  auto methodDecl =
+      resolveMethodOverload(ctx, parsetree::Symbol{}, argType, loc, true);
   // override
   expr->setResolvedDecl(methodDecl);
 
@@ -1019,7 +973,7 @@ bool ExprResolver::isAccessible(
       std::dynamic_pointer_cast<parsetree::ast::ClassDecl>(parent);
   if (auto curClass = std::dynamic_pointer_cast<parsetree::ast::ClassDecl>(
           currentProgram->getBody())) {
-    if (isSuperClass(targetClass, curClass))
+    if (astManager->hierarchy.isSuperClass(targetClass, curClass))
       return true;
   }
   // same package
@@ -1108,7 +1062,7 @@ void ExprResolver::resolveFieldAccess(std::shared_ptr<ExprNameLinked> access) {
   }
 
   // Next, fetch the type or declaration
-  auto name = access->getNode()->getName();
+  auto name = access->getNode()->getSymbol();
   auto typeOrDecl = access->prevAsDecl(typeResolver, astManager, typeLinker);
   std::shared_ptr<parsetree::ast::CodeBody> refType = nullptr;
   // If the previous node is linked, retrieve its type information.
@@ -1149,7 +1103,7 @@ void ExprResolver::resolveFieldAccess(std::shared_ptr<ExprNameLinked> access) {
   auto loc = source::SourceRange();
   auto field = lookupNamedDecl(refType, name, loc);
   if (!field) {
-    throw std::runtime_error("field access failed for " + name);
+    throw std::runtime_error("field access failed for " + name.str());
   }
   // Ensure the resolved field is either a FieldDecl or MethodDecl
   if (!std::dynamic_pointer_cast<parsetree::ast::FieldDecl>(field) &&
@@ -1185,18 +1139,18 @@ void ExprResolver::resolveTypeAccess(std::shared_ptr<ExprNameLinked> access) {
       throw std::runtime_error("Not a type name, Not a type access");
   }
   // Next, fetch the type or declaration
-  auto name = access->getNode()->getName();
+  auto name = access->getNode()->getSymbol();
   auto typeOrDecl = access->prevAsDecl(typeResolver, astManager, typeLinker);
   // We note this must be a class type or we have a type error
   auto type = std::dynamic_pointer_cast<parsetree::ast::ClassDecl>(typeOrDecl);
   if (!type) {
     throw std::runtime_error("static member access to non-class type for " +
-                             name);
+                             name.str());
   }
   // Now we check if "name" is a field of "decl".
   auto field = lookupNamedDecl(type, name, access->getNode()->getLoc());
   if (!field) {
-    throw std::runtime_error("type access failed for " + name);
+    throw std::runtime_error("type access failed for " + name.str());
   }
   // With the additional constraint that the field must be static
   std::shared_ptr<parsetree::ast::Modifiers> mods;
@@ -1222,7 +1176,7 @@ void ExprResolver::resolveTypeAccess(std::shared_ptr<ExprNameLinked> access) {
             field->getParent())) {
       if (currentClass) {
         if (fieldClass != currentClass &&
-            !isSuperClass(fieldClass, currentClass)) {
+            !astManager->hierarchy.isSuperClass(fieldClass, currentClass)) {
           throw std::runtime_error("cannot access protected field " +
                                    field->getName() + " from class " +
                                    currentClass->getName());
@@ -1282,9 +1236,7 @@ void ExprResolver::resolvePackageAccess(
     if (!pkgdecl.getAstNode()) {
       throw std::runtime_error("package should be resolved but not!");
     }
-    auto pkgType =
-        std::make_shared<parsetree::ast::ReferenceType>(pkgdecl.getAstNode());
-    pkgType->setResolvedDecl(pkgdecl);
+    auto pkgType = astManager->types.getReferenceType(pkgdecl.getAstNode());
     access->getNode()->resolveDeclAndType(pkgdecl.getAstNode(), pkgType);
   } else {
     access->setValueType(ExprNameLinked::ValueType::PackageName);
@@ -1376,12 +1328,12 @@ static void removeDuplicates(
  *         ambiguity error.
  */
 std::shared_ptr<parsetree::ast::MethodDecl> ExprResolver::resolveMethodOverload(
-    std::shared_ptr<parsetree::ast::CodeBody> ctx, std::string name,
+    std::shared_ptr<parsetree::ast::CodeBody> ctx, parsetree::Symbol name,
     const std::vector<std::shared_ptr<parsetree::ast::Type>> &argTypes,
     const source::SourceRange loc, bool isConstructor) {
   // Set the name to the constructor name if isConstructor is true
   if (isConstructor)
-    name = ctx->asDecl()->getName();
+    name = ctx->asDecl()->getSymbol();
   // 15.12.2.1
   std::vector<std::shared_ptr<parsetree::ast::MethodDecl>> candidates;
   if (isConstructor) {
@@ -1416,12 +1368,13 @@ std::shared_ptr<parsetree::ast::MethodDecl> ExprResolver::resolveMethodOverload(
     // 2. Parameters are convertible
     // 3. Method is accessible
     auto ctxDecl = ctx->asDecl();
-    auto result = hierarchyChecker->getAllInheritedMethods(ctxDecl);
+    const auto &result = hierarchyChecker->getAllInheritedMethods(ctxDecl);
     if (!result.success)
       throw std::runtime_error("Failed to get inherited methods");
 
     // should we also loop through abstract methods?
-    std::unordered_map<std::string, std::shared_ptr<parsetree::ast::MethodDecl>>
+    std::unordered_map<parsetree::Symbol,
+                       std::shared_ptr<parsetree::ast::MethodDecl>>
         allMethods = result.methods;
     allMethods.insert(result.abstractMethods.begin(),
                       result.abstractMethods.end());
@@ -1442,7 +1395,7 @@ std::shared_ptr<parsetree::ast::MethodDecl> ExprResolver::resolveMethodOverload(
         continue;
       if (decl->getParams().size() != argTypes.size())
         continue;
-      if (decl->getName() != name)
+      if (decl->getSymbol() != name)
         continue;
       if (!areParameterTypesApplicable(decl, argTypes))
         continue;
@@ -1457,9 +1410,9 @@ std::shared_ptr<parsetree::ast::MethodDecl> ExprResolver::resolveMethodOverload(
   }
   if (candidates.size() == 0) {
     if (isConstructor) {
-      throw std::runtime_error("no constructor found for " + std::string(name));
+      throw std::runtime_error("no constructor found for " + name.str());
     } else {
-      throw std::runtime_error("no method found for " + std::string(name));
+      throw std::runtime_error("no method found for " + name.str());
     }
   }
   if (candidates.size() == 1)
@@ -1501,7 +1454,7 @@ std::shared_ptr<parsetree::ast::MethodDecl> ExprResolver::resolveMethodOverload(
     cur->print(std::cout);
     std::cout << std::endl;
   }
-  throw std::runtime_error("ambiguous method found for " + std::string(name));
+  throw std::runtime_error("ambiguous method found for " + name.str());
 }
 
 bool ExprResolver::areParameterTypesApplicable(
@@ -1539,13 +1492,11 @@ bool ExprResolver::isMethodMoreSpecific(
     std::shared_ptr<parsetree::ast::MethodDecl> b) const {
   auto aDecl =
       Decl{std::dynamic_pointer_cast<parsetree::ast::Decl>(a->getParent())};
-  auto T = std::make_shared<parsetree::ast::ReferenceType>(aDecl.getAstNode());
-  T->setResolvedDecl(aDecl);
+  auto T = astManager->types.getReferenceType(aDecl.getAstNode());
 
   auto bDecl =
       Decl{std::dynamic_pointer_cast<parsetree::ast::Decl>(b->getParent())};
-  auto U = std::make_shared<parsetree::ast::ReferenceType>(bDecl.getAstNode());
-  U->setResolvedDecl(bDecl);
+  auto U = astManager->types.getReferenceType(bDecl.getAstNode());
 
   if (!typeResolver->isAssignableTo(U, T))
     return false;
@@ -24,7 +24,7 @@ void precomputeExprStatement(
   auto expr = exprStmt->getStatementExpr();
   if (!expr)
     return;
-  auto exprNodes = expr->getExprNodes();
+  const auto &exprNodes = expr->getExprNodes();
   // If assignment expression (with simple name), first node should be
   // identifier and last node should be =
   // TODO: Known issue, how to get variables used in field access or array
@@ -75,9 +75,9 @@ void precomputeExpr(std::shared_ptr<parsetree::ast::Expr> expr,
   // std::cout << "precomputeExpr\n";
   if (!expr)
     return;
-  auto exprNodes = expr->getExprNodes();
+  const auto &exprNodes = expr->getExprNodes();
   auto &use = node->getLiveVariableAnalysisInfo()->use();
-  for (auto exprNode : exprNodes) {
+  for (const auto &exprNode : exprNodes) {
     auto lvalue =
         std::dynamic_pointer_cast<parsetree::ast::MemberName>(exprNode);
     // std::cout << "isLocalVariable: " << lvalue->getName() << " " <<
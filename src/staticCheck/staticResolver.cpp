@@ -2,43 +2,6 @@
 
 namespace static_check {
 
-// Taken from HierarchyCheck
-static bool isClass(std::shared_ptr<parsetree::ast::AstNode> decl) {
-  return !!std::dynamic_pointer_cast<parsetree::ast::ClassDecl>(decl);
-}
-
-static bool isSuperClass(std::shared_ptr<parsetree::ast::AstNode> super,
-                         std::shared_ptr<parsetree::ast::AstNode> child) {
-  if (!child || !super) {
-    return false;
-  }
-  if (!isClass(child)) {
-    return false;
-  }
-  if (!isClass(super)) {
-    return false;
-  }
-  auto childDecl = std::dynamic_pointer_cast<parsetree::ast::ClassDecl>(child);
-  auto superDecl = std::dynamic_pointer_cast<parsetree::ast::ClassDecl>(super);
-
-  for (auto &superClass : childDecl->getSuperClasses()) {
-    if (!superClass || !superClass->getResolvedDecl().getAstNode())
-      continue;
-
-    // Cast to class
-    auto superClassDecl = std::dynamic_pointer_cast<parsetree::ast::ClassDecl>(
-        superClass->getResolvedDecl().getAstNode());
-
-    if (superClassDecl == superDecl)
-      return true;
-
-    if (isSuperClass(super, std::dynamic_pointer_cast<parsetree::ast::AstNode>(
-                                superClassDecl)))
-      return true;
-  }
-  return false;
-}
-
 void StaticResolver::evaluate(std::shared_ptr<parsetree::ast::Expr> expr,
                               StaticResolverState state) {
   this->state = state;
@@ -73,7 +36,7 @@ void StaticResolver::checkInstanceVariable(StaticResolverData variable,
   if (state.isInstFieldInitializer && checkInitOrder) {
     auto fieldDecl =
         std::dynamic_pointer_cast<parsetree::ast::FieldDecl>(variable.decl);
-    if (!state.fieldScope->canView(fieldDecl->getScope())) {
+    if (!state.fieldScope.canView(fieldDecl->getScope())) {
       throw std::runtime_error("cannot access instance members in initializer "
                                "before they are defined");
     }
@@ -118,7 +81,7 @@ void StaticResolver::isAccessible(StaticResolverData lhs,
               state.currentClass->getParent());
       auto lhsProgram = std::dynamic_pointer_cast<parsetree::ast::ProgramDecl>(
           lhsClass->getParent());
-      if (!isSuperClass(state.currentClass, lhsClass) &&
+      if (!astManager->hierarchy.isSuperClass(state.currentClass, lhsClass) &&
           (currentProgram->getPackageName() != lhsProgram->getPackageName())) {
         throw std::runtime_error("cannot access protected method: " +
                                  lhsClass->getName() + "." + method->getName());
@@ -132,7 +95,7 @@ void StaticResolver::isAccessible(StaticResolverData lhs,
               state.currentClass->getParent());
       auto lhsProgram = std::dynamic_pointer_cast<parsetree::ast::ProgramDecl>(
           lhsClass->getParent());
-      if (!isSuperClass(state.currentClass, lhsClass) &&
+      if (!astManager->hierarchy.isSuperClass(state.currentClass, lhsClass) &&
           currentProgram->getPackageName() != lhsProgram->getPackageName()) {
         throw std::runtime_error("cannot access protected field: " +
                                  lhsClass->getName() + "." + field->getName());
@@ -1,4 +1,10 @@
 #include "staticCheck/typeLinker.hpp"
+#include "utils/timeReport.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
 
 namespace static_check {
 
@@ -16,19 +22,23 @@ void TypeLinker::buildSymbolTable() {
 
     // Traverse the package name to find the leaf package.
     std::shared_ptr<Package> currentPackage = rootPackage;
-    for (const auto &id : package->getIdentifiers()) {
+    std::vector<parsetree::Symbol> qualifiedName;
+    for (const auto id : package->getIdentifiers()) {
+      qualifiedName.push_back(id);
       // If the subpackage name is not in the symbol table, add it
       // and continue to the next one.
-      if (currentPackage->children.find(id) == currentPackage->children.end()) {
-        auto newPackage = std::make_shared<Package>(id);
-        currentPackage->children[id] = newPackage;
+      if (currentPackage->children.find(id.str()) ==
+          currentPackage->children.end()) {
+        auto newPackage = std::make_shared<Package>(id.str());
+        currentPackage->children[id.str()] = newPackage;
+        qualifiedIndex[qualifiedName] = newPackage;
         currentPackage = newPackage;
         continue;
       }
       // The subpackage name already exists.
-      auto const &child = currentPackage->children[id];
+      auto const &child = currentPackage->children[id.str()];
       if (std::holds_alternative<std::shared_ptr<Decl>>(child)) {
-        throw std::runtime_error("Prefix include a decl for at " + id);
+        throw std::runtime_error("Prefix include a decl for at " + id.str());
       }
       // Get the next subpackage.
       currentPackage = std::get<std::shared_ptr<Package>>(child);
@@ -36,6 +46,7 @@ void TypeLinker::buildSymbolTable() {
     if (programDecl->isDefaultPackage()) {
       currentPackage = std::get<std::shared_ptr<Package>>(
           currentPackage->children[DEFAULT_PACKAGE_NAME]);
+      qualifiedName.push_back(parsetree::Symbol{DEFAULT_PACKAGE_NAME});
     }
 
     // now we are at leaf package
@@ -52,11 +63,18 @@ void TypeLinker::buildSymbolTable() {
       throw std::runtime_error("Duplicate declaration at " + body->getName());
     }
     // add to symbol table
-    currentPackage->children[body->getName()] = std::make_shared<Body>(body);
+    std::shared_ptr<Decl> decl = std::make_shared<Body>(body);
+    currentPackage->children[body->getName()] = decl;
+    qualifiedName.push_back(body->getSymbol());
+    qualifiedIndex[std::move(qualifiedName)] = decl;
+    simpleNameIndex[body->getSymbol()].push_back(decl);
   }
 }
 
-void TypeLinker::resolveAST(std::shared_ptr<parsetree::ast::AstNode> node) {
+void TypeLinker::resolveAST(
+    std::shared_ptr<parsetree::ast::AstNode> node,
+    std::shared_ptr<parsetree::ast::ProgramDecl> program,
+    std::vector<std::shared_ptr<parsetree::ast::Decl>> &decls) {
   if (!node)
     throw std::runtime_error("Node is null when resolving AST");
 
@@ -64,19 +82,19 @@ void TypeLinker::resolveAST(std::shared_ptr<parsetree::ast::AstNode> node) {
           std::dynamic_pointer_cast<parsetree::ast::ClassDecl>(node)) {
     // std::cout << "typeLinker pushing class " << classDecl->getFullName()
     //           << " into allDecls\n";
-    astManager->allDecls.push_back(classDecl);
+    decls.push_back(classDecl);
   } else if (auto interfaceDecl =
                  std::dynamic_pointer_cast<parsetree::ast::InterfaceDecl>(
                      node)) {
     // std::cout << "typeLinker pushing interface " <<
     // interfaceDecl->getFullName()
     //           << " into allDecls\n";
-    astManager->allDecls.push_back(interfaceDecl);
+    decls.push_back(interfaceDecl);
   }
 
-  for (auto child : node->getChildren()) {
+  node->forEachChild([&](const auto &child) {
     if (!child)
-      continue;
+      return;
 
     // Case: Type
     if (auto type = std::dynamic_pointer_cast<parsetree::ast::Type>(child)) {
@@ -84,9 +102,9 @@ void TypeLinker::resolveAST(std::shared_ptr<parsetree::ast::AstNode> node) {
       if (!(type->isResolved())) {
         if (auto array =
                 std::dynamic_pointer_cast<parsetree::ast::ArrayType>(type)) {
-          resolveType(array->getElementType());
+          resolveType(array->getElementType(), program);
         } else {
-          resolveType(type);
+          resolveType(type, program);
         }
       } else {
         // std::cout << "skipping resolve type for ";
@@ -97,18 +115,80 @@ void TypeLinker::resolveAST(std::shared_ptr<parsetree::ast::AstNode> node) {
     }
     // Case: regular code
     else {
-      resolveAST(child);
+      resolveAST(child, program, decls);
     }
-  }
+  });
 }
 
 // Second pass
-void TypeLinker::resolve() {
-  for (auto ast : astManager->getASTs()) {
-    initContext(ast);
-    resolveAST(ast->getBody());
-    // resolveAST(ast);
+void TypeLinker::resolve(unsigned numJobs) {
+  const auto &asts = astManager->getASTs();
+  for (const auto &ast : asts) {
+    contextMap[ast] = Context{};
   }
+
+  // After buildSymbolTable the package trie and the indexes are only read,
+  // a unit writes to nothing but its own AST, context and decls
+  std::vector<std::vector<std::shared_ptr<parsetree::ast::Decl>>> decls(
+      asts.size());
+  std::vector<std::exception_ptr> errors(asts.size());
+  auto linkUnit = [&](size_t i) {
+    // Only name the unit when someone reads the report
+    std::string unitName;
+    if (utils::TimeReport::active())
+      unitName = asts[i]->getBody()->asDecl()->getName();
+    utils::TimeReport::Scope unit{"type linking", std::move(unitName)};
+    try {
+      initContext(asts[i]);
+      resolveAST(asts[i]->getBody(), asts[i], decls[i]);
+    } catch (...) {
+      errors[i] = std::current_exception();
+    }
+  };
+
+  if (numJobs <= 1 || asts.size() <= 1) {
+    for (size_t i = 0; i < asts.size(); ++i) {
+      linkUnit(i);
+      if (errors[i])
+        break;
+    }
+  } else {
+    // Same scheme as the front end: once a unit fails, units after it are
+    // skipped since the serial path would never have reached them
+    std::atomic<size_t> nextUnit = 0;
+    std::atomic<size_t> firstFailure = asts.size();
+    auto worker = [&]() {
+      for (size_t i = nextUnit++; i < asts.size(); i = nextUnit++) {
+        if (i > firstFailure)
+          continue;
+        linkUnit(i);
+        if (errors[i]) {
+          size_t expected = firstFailure;
+          while (i < expected &&
+                 !firstFailure.compare_exchange_weak(expected, i))
+            ;
+        }
+      }
+    };
+    std::vector<std::thread> workers;
+    for (unsigned j = 0; j < std::min<size_t>(numJobs, asts.size()); ++j) {
+      workers.emplace_back(worker);
+    }
+    for (auto &thread : workers) {
+      thread.join();
+    }
+  }
+
+  // Merge in AST order so allDecls and the reported error don't depend on
+  // the thread count
+  for (size_t i = 0; i < asts.size(); ++i) {
+    if (errors[i])
+      std::rethrow_exception(errors[i]);
+    astManager->allDecls.insert(astManager->allDecls.end(),
+                                decls[i].begin(), decls[i].end());
+  }
+  if (!asts.empty())
+    currentProgram = asts.back();
 }
 
 // //////////////////// Helpers ////////////////////
@@ -121,8 +201,7 @@ void TypeLinker::initContext(
   // } else {
   //   std::cout << node->getPackageName() << std::endl;
   // }
-  auto &context = contextMap[node];
-  currentProgram = node;
+  auto &context = getContext(node);
   auto packageAstNode =
       std::dynamic_pointer_cast<parsetree::ast::UnresolvedType>(
           node->getPackage());
@@ -139,10 +218,12 @@ void TypeLinker::initContext(
   3. Add Decl from the Same Package (Different ASTs)
   4. Single-Type Imports (import pkg.ClassName)
   5. All Decl from the Current AST
+  Each step shadows the ones before it. Only the imports are checked here,
+  lookupName applies the steps in reverse when a name is first used.
   */
 
   // Step 1: Import-on-Demand Declarations (import pkg.*)
-  for (auto impt : node->getImports()) {
+  for (const auto &impt : node->getImports()) {
     if (!impt->hasStar())
       continue; // not on demand
     auto imptPkg =
@@ -154,43 +235,15 @@ void TypeLinker::initContext(
       throw std::runtime_error("Failed to resolve import-on-demand to package");
     }
     auto pkg = std::get<std::shared_ptr<Package>>(imptPkg);
-
-    // add all decl of package to context
-    for (auto &tuple : pkg->children) {
-      auto key = tuple.first;
-      auto value = tuple.second;
-      // we only add decl
-      if (!std::holds_alternative<std::shared_ptr<Decl>>(value))
-        continue;
-      auto decl = std::get<std::shared_ptr<Decl>>(value);
-      if (context.find(key) != context.end()) {
-        // already in context by another on demand import
-        // I think this is an ambiguous case
-        if (std::holds_alternative<std::shared_ptr<Decl>>(context[key]) &&
-            std::get<std::shared_ptr<Decl>>(context[key]) == decl) {
-          // same import, all good
-          continue;
-        }
-        // different import from different package
-        // ambiguous?
-        context[key] = Package::packageChild{nullptr};
-        continue;
-      }
-      context[key] = Package::packageChild{decl};
-    }
+    // same package imported twice is not ambiguous
+    if (std::find(context.onDemandImports.begin(),
+                  context.onDemandImports.end(),
+                  pkg) == context.onDemandImports.end())
+      context.onDemandImports.push_back(pkg);
   }
 
   // Step 2: Add Package Declarations
-  for (auto &tuple : rootPackage->children) {
-    // only import package
-    if (!std::holds_alternative<std::shared_ptr<Package>>(tuple.second))
-      continue;
-    if (context.find(tuple.first) == context.end()) {
-      // only add package not shadowed by on demand import
-      context[tuple.first] = Package::packageChild{
-          std::get<std::shared_ptr<Package>>(tuple.second)};
-    }
-  }
+  // top level packages are looked up in rootPackage directly
 
   // Step 3: Add Decl from the Same Package (Different ASTs)
   // info already in symbol table, no need another loop of ast
@@ -198,19 +251,10 @@ void TypeLinker::initContext(
   if (!std::holds_alternative<std::shared_ptr<Package>>(currentPackage)) {
     throw std::runtime_error("Failed to get current package");
   }
-  for (auto &pair :
-       std::get<std::shared_ptr<Package>>(currentPackage)->children) {
-    auto key = pair.first;
-    auto value = pair.second;
-    // we only add decl
-    if (!std::holds_alternative<std::shared_ptr<Decl>>(value))
-      continue;
-    auto decl = std::get<std::shared_ptr<Decl>>(value);
-    context[key] = Package::packageChild{decl};
-  }
+  context.package = std::get<std::shared_ptr<Package>>(currentPackage);
 
   // Step 4: Single-Type Imports (import pkg.ClassName)
-  for (auto impt : node->getImports()) {
+  for (const auto &impt : node->getImports()) {
     if (impt->hasStar()) {
       continue; // skip on-demand imports
     }
@@ -223,26 +267,26 @@ void TypeLinker::initContext(
           impt->getQualifiedIdentifier()->toString());
     }
     auto decl = std::get<std::shared_ptr<Decl>>(imptType);
-    auto typeName = decl->getName();
+    auto typeName = decl->getSymbol();
     // Check: decl name should not clash with class name
     auto classDecl =
         std::dynamic_pointer_cast<parsetree::ast::Decl>(node->getBody());
     if (!classDecl)
       throw std::runtime_error("Body not Decl");
-    if (classDecl->getName() == typeName && decl->getAstNode() != classDecl) {
+    if (classDecl->getSymbol() == typeName &&
+        decl->getAstNode() != classDecl) {
       throw std::runtime_error("Single-Type Import name clash with class name" +
                                decl->getName());
     }
 
-    context[typeName] = Package::packageChild{decl};
+    context.singleTypeImports[typeName] = decl;
   }
 
   // Step 5: All Decl from the Current AST
   // this will shadow everything
   if (auto body = node->getBody()) {
     if (auto bodyDecl = std::dynamic_pointer_cast<parsetree::ast::Decl>(body)) {
-      context[bodyDecl->getName()] =
-          Package::packageChild{std::make_shared<Body>(bodyDecl)};
+      context.body = std::make_shared<Body>(bodyDecl);
     } else {
       throw std::runtime_error(
           "Body is not Decl in initContext, this should not happen");
@@ -250,6 +294,50 @@ void TypeLinker::initContext(
   }
 }
 
+TypeLinker::Context::Entry
+TypeLinker::lookupName(const Context &context,
+                       parsetree::Symbol simpleName) const {
+  // Step 5
+  if (context.body && context.body->getSymbol() == simpleName)
+    return {context.body};
+
+  // Step 4
+  auto imported = context.singleTypeImports.find(simpleName);
+  if (imported != context.singleTypeImports.end())
+    return {imported->second};
+
+  // Step 3, the package trie is still keyed by spelling. This runs once per
+  // name and unit, the result is remembered in Context::names.
+  auto sibling = context.package->children.find(simpleName.str());
+  if (sibling != context.package->children.end() &&
+      std::holds_alternative<std::shared_ptr<Decl>>(sibling->second))
+    return {sibling->second};
+
+  // Step 1, a name found in two different packages is ambiguous, which
+  // also hides a package of the same name
+  std::shared_ptr<Decl> onDemand;
+  for (const auto &pkg : context.onDemandImports) {
+    auto it = pkg->children.find(simpleName.str());
+    if (it == pkg->children.end() ||
+        !std::holds_alternative<std::shared_ptr<Decl>>(it->second))
+      continue;
+    auto decl = std::get<std::shared_ptr<Decl>>(it->second);
+    if (onDemand && onDemand != decl)
+      return {nullptr, true};
+    onDemand = decl;
+  }
+  if (onDemand)
+    return {onDemand};
+
+  // Step 2
+  auto pkg = rootPackage->children.find(simpleName.str());
+  if (pkg != rootPackage->children.end() &&
+      std::holds_alternative<std::shared_ptr<Package>>(pkg->second))
+    return {pkg->second};
+
+  return {nullptr};
+}
+
 Package::packageChild TypeLinker::resolveImport(
     std::shared_ptr<parsetree::ast::UnresolvedType> node) {
   // Base cases
@@ -258,30 +346,41 @@ Package::packageChild TypeLinker::resolveImport(
   if (node->isResolved())
     throw std::runtime_error("unresolved type should not be resolved yet");
   if (node->getIdentifiers().size() == 0) {
-    return rootPackage->children[DEFAULT_PACKAGE_NAME];
+    return rootPackage->children.at(DEFAULT_PACKAGE_NAME);
   }
   return resolveImport(node->getIdentifiers());
 }
 
 Package::packageChild
-TypeLinker::resolveImport(const std::vector<std::string> &identifiers) {
+TypeLinker::resolveImport(const std::vector<parsetree::Symbol> &identifiers) {
   if (identifiers.size() == 0) {
-    return rootPackage->children[DEFAULT_PACKAGE_NAME];
+    return rootPackage->children.at(DEFAULT_PACKAGE_NAME);
   }
-  Package::packageChild current = rootPackage;
-  for (auto &id : identifiers) {
-    if (std::holds_alternative<std::shared_ptr<Decl>>(current)) {
-      throw std::runtime_error("internal node should not be decl");
-    }
-    auto pkg = std::get<std::shared_ptr<Package>>(current);
-    if (pkg->children.find(id) == pkg->children.end()) {
-      throw std::runtime_error("Could not resolve " + id +
-                               " since this is not found");
-    }
-    current = pkg->children.at(id);
+  auto it = qualifiedIndex.find(identifiers);
+  if (it == qualifiedIndex.end()) {
+    std::string name;
+    for (const auto &id : identifiers)
+      name += (name.empty() ? "" : ".") + id.str();
+    throw std::runtime_error("Could not resolve " + name +
+                             " since this is not found");
   }
-  // return the leaf node
-  return current;
+  return it->second;
+}
+
+Package::packageChild TypeLinker::resolveRest(
+    const Package::packageChild &first,
+    const std::vector<parsetree::Symbol> &identifiers) const {
+  if (identifiers.size() == 1)
+    return first;
+  // interior nodes in the tree should not be decl
+  if (std::holds_alternative<std::shared_ptr<Decl>>(first)) {
+    throw std::runtime_error(
+        "resolving package should not be decl when resolving type");
+  }
+  // The only packages a simple name resolves to are the top level ones, so
+  // the identifiers are already the fully qualified name
+  auto it = qualifiedIndex.find(identifiers);
+  return it != qualifiedIndex.end() ? it->second : nullptr;
 }
 
 void TypeLinker::resolveType(
@@ -298,35 +397,18 @@ void TypeLinker::resolveType(
   if (unresolvedType->getIdentifiers().size() == 0)
     return; // ??
 
-  Package::packageChild currentType;
-  bool first = true;
-  // std::cout << "resolving type: ";
-  // for (auto &id : unresolvedType->getIdentifiers()) {
-  //   std::cout << id << " ";
-  // }
-  // std::cout << std::endl;
-  for (auto &id : unresolvedType->getIdentifiers()) {
-    if (first) {
-      currentType = resolveSimpleName(id, program);
-      if (std::holds_alternative<std::nullptr_t>(currentType)) {
-        throw std::runtime_error(
-            "Could not resolve type at " + id +
-            " due to failed resolveSimpleName at resolveType");
-      }
-      first = false;
-    } else {
-      // interior nodes in the tree should not be decl
-      if (std::holds_alternative<std::shared_ptr<Decl>>(currentType)) {
-        throw std::runtime_error(
-            "resolving package should not be decl when resolving type");
-      }
-      auto pkg = std::get<std::shared_ptr<Package>>(currentType);
-      if (pkg->children.find(id) == pkg->children.end()) {
-        throw std::runtime_error("Could not resolve type " + id +
-                                 " since this is not found");
-      }
-      currentType = pkg->children.at(id);
-    }
+  const auto &identifiers = unresolvedType->getIdentifiers();
+  auto currentType = resolveSimpleName(identifiers.front(), program);
+  if (std::holds_alternative<std::nullptr_t>(currentType)) {
+    throw std::runtime_error("Could not resolve type at " +
+                             identifiers.front().str() +
+                             " due to failed resolveSimpleName at resolveType");
+  }
+  currentType = resolveRest(currentType, identifiers);
+  if (std::holds_alternative<std::nullptr_t>(currentType)) {
+    throw std::runtime_error("Could not resolve type " +
+                             unresolvedType->toString() +
+                             " since this is not found");
   }
   // check the leaf node is decl
   if (!std::holds_alternative<std::shared_ptr<Decl>>(currentType)) {
@@ -355,39 +437,23 @@ std::shared_ptr<Decl> TypeLinker::resolveTypeAgain(
   if (unresolvedType->getIdentifiers().size() == 0)
     return nullptr; // ??
 
-  Package::packageChild currentType;
-  bool first = true;
-  // std::cout << "resolving type again: ";
-  // for (auto &id : unresolvedType->getIdentifiers()) {
-  //   std::cout << id << " ";
-  // }
-  // std::cout << std::endl;
-  for (auto &id : unresolvedType->getIdentifiers()) {
-    if (first) {
-      currentType = resolveClassName(id);
-      if (std::holds_alternative<std::nullptr_t>(currentType)) {
-        currentType = resolveSimpleName(id, program);
-        if (std::holds_alternative<std::nullptr_t>(currentType)) {
-          throw std::runtime_error("Could not resolve type at " + id +
-                                   " due to failed resolveSimpleName and "
-                                   "resolveClassName at resolveTypeAgain");
-        }
-      }
-      first = false;
-    } else {
-      // interior nodes in the tree should not be decl
-      if (std::holds_alternative<std::shared_ptr<Decl>>(currentType)) {
-        throw std::runtime_error(
-            "resolving package should not be decl when resolving type");
-      }
-      auto pkg = std::get<std::shared_ptr<Package>>(currentType);
-      if (pkg->children.find(id) == pkg->children.end()) {
-        throw std::runtime_error("Could not resolve type " + id +
-                                 " since this is not found");
-      }
-      currentType = pkg->children.at(id);
+  const auto &identifiers = unresolvedType->getIdentifiers();
+  auto currentType = resolveClassName(identifiers.front());
+  if (std::holds_alternative<std::nullptr_t>(currentType)) {
+    currentType = resolveSimpleName(identifiers.front(), program);
+    if (std::holds_alternative<std::nullptr_t>(currentType)) {
+      throw std::runtime_error("Could not resolve type at " +
+                               identifiers.front().str() +
+                               " due to failed resolveSimpleName and "
+                               "resolveClassName at resolveTypeAgain");
     }
   }
+  currentType = resolveRest(currentType, identifiers);
+  if (std::holds_alternative<std::nullptr_t>(currentType)) {
+    throw std::runtime_error("Could not resolve type " +
+                             unresolvedType->toString() +
+                             " since this is not found");
+  }
   // check the leaf node is decl
   if (!std::holds_alternative<std::shared_ptr<Decl>>(currentType)) {
     throw std::runtime_error("resolved type should be decl");
@@ -396,40 +462,31 @@ std::shared_ptr<Decl> TypeLinker::resolveTypeAgain(
 }
 
 Package::packageChild TypeLinker::resolveSimpleName(
-    const std::string &simpleName,
+    parsetree::Symbol simpleName,
     std::shared_ptr<parsetree::ast::ProgramDecl> program) {
   if (!program) {
     program = currentProgram;
   }
-  auto &context = contextMap[program];
-  return context.find(simpleName) != context.end() ? context[simpleName]
-                                                   : nullptr;
+  auto &context = getContext(program);
+  auto [it, inserted] = context.names.try_emplace(simpleName);
+  if (inserted)
+    it->second = lookupName(context, simpleName);
+  if (it->second.ambiguous)
+    throw std::runtime_error("Ambiguous import-on-demand of " +
+                             simpleName.str());
+  return it->second.child;
 }
 
 Package::packageChild
-TypeLinker::resolveClassName(const std::string &simpleName) {
-  for (const auto &[programDecl, packageMap] : contextMap) {
-    for (const auto &[key, value] : packageMap) {
-      if (auto declPtr = std::get_if<std::shared_ptr<Decl>>(&value)) {
-        if (*declPtr && key == simpleName) {
-          return value;
-        }
-      } else if (auto pkgPtr = std::get_if<std::shared_ptr<Package>>(&value)) {
-        if (*pkgPtr) {
-          auto result = (*pkgPtr)->findDeclRecursive(simpleName);
-          if (result.has_value()) {
-            return *result;
-          }
-        }
-      }
-    }
-  }
-
-  return nullptr;
+TypeLinker::resolveClassName(parsetree::Symbol simpleName) {
+  auto it = simpleNameIndex.find(simpleName);
+  if (it == simpleNameIndex.end())
+    return nullptr;
+  return it->second.front();
 }
 
 Package::packageChild TypeLinker::resolveQualifiedName(
-    const std::vector<std::string> &identifiers,
+    const std::vector<parsetree::Symbol> &identifiers,
     std::shared_ptr<parsetree::ast::ProgramDecl> program) {
   if (identifiers.empty()) {
     return nullptr;
@@ -437,33 +494,13 @@ Package::packageChild TypeLinker::resolveQualifiedName(
   if (!program) {
     program = currentProgram;
   }
-  auto &context = contextMap[program];
-  Package::packageChild current;
-  bool first = true;
-  for (auto &id : identifiers) {
-    if (first) {
-      current = resolveSimpleName(id, program);
-      if (std::holds_alternative<std::nullptr_t>(current)) {
-        throw std::runtime_error(
-            "Could not resolve type at " + id +
-            " due to failed resolveSimpleName at resolveQualifiedName");
-      }
-      first = false;
-      continue;
-    }
-    // interior nodes in the tree should not be decl
-    if (std::holds_alternative<std::shared_ptr<Decl>>(current)) {
-      throw std::runtime_error(
-          "resolving package should not be decl when resolving type");
-    }
-    auto pkg = std::get<std::shared_ptr<Package>>(current);
-    if (pkg->children.find(id) == pkg->children.end()) {
-      // not found
-      return nullptr;
-    }
-    current = pkg->children.at(id);
+  auto current = resolveSimpleName(identifiers.front(), program);
+  if (std::holds_alternative<std::nullptr_t>(current)) {
+    throw std::runtime_error(
+        "Could not resolve type at " + identifiers.front().str() +
+        " due to failed resolveSimpleName at resolveQualifiedName");
   }
-  return current;
+  return resolveRest(current, identifiers);
 }
 
 void TypeLinker::populateJavaLang() {
@@ -577,20 +614,24 @@ void TypeLinker::populateJavaLang() {
   lengthModifier->set(parsetree::Modifier::Type::Final);
   publicModifier->set(parsetree::Modifier::Type::Public);
 
-  auto type = std::make_shared<parsetree::ast::BasicType>(
-      parsetree::BasicType::Type::Int);
+  auto type =
+      astManager->types.getBasicType(parsetree::ast::BasicType::Type::Int);
   source::SourceRange loc;
-  auto length = envManager->BuildFieldDecl(lengthModifier, type, "length",
-                                           nullptr, loc, true);
+  // The array class is not parsed, so nothing has opened its field scope
+  envManager->ResetFieldScope();
+  auto length = envManager->BuildFieldDecl(
+      lengthModifier, type, parsetree::Symbol{"length"}, nullptr, loc, true);
   auto nullBlock = std::make_shared<parsetree::ast::Block>();
+  const parsetree::Symbol arrayName{"_hardcoded_array"};
   auto constructor =
-      envManager->BuildMethodDecl(publicModifier, "_hardcoded_array", nullptr,
-                                  emptyParams, true, nullBlock, loc);
+      envManager->BuildMethodDecl(publicModifier, arrayName, nullptr,
+                                  std::move(emptyParams), true, nullBlock, loc);
   body.push_back(length);
   body.push_back(constructor);
   astManager->java_lang.Array = envManager->BuildClassDecl(
-      publicModifier, "_hardcoded_array", nullptr, interfaces, body);
-  (void)envManager->BuildProgramDecl(nullptr, emptyImports,
+      publicModifier, arrayName, nullptr, std::move(interfaces),
+      std::move(body));
+  (void)envManager->BuildProgramDecl(nullptr, std::move(emptyImports),
                                      astManager->java_lang.Array);
 }
 
@@ -10,9 +10,9 @@ void TypeResolver::resolve() {
 
 bool TypeResolver::isReferenceOrArrType(
     std::shared_ptr<parsetree::ast::Type> type) const {
-  return std::dynamic_pointer_cast<parsetree::ast::ReferenceType>(type) ||
-         std::dynamic_pointer_cast<parsetree::ast::ArrayType>(type) ||
-         type->isString();
+  const auto kind = type->getTypeKind();
+  return kind == parsetree::ast::Type::TypeKind::Reference ||
+         kind == parsetree::ast::Type::TypeKind::Array || type->isString();
 }
 
 // Check if is Java string
@@ -21,120 +21,23 @@ bool TypeResolver::isTypeString(
   if (type->isString())
     return true;
   if (auto refType =
-          std::dynamic_pointer_cast<parsetree::ast::ReferenceType>(type)) {
+          parsetree::ast::typeCast<parsetree::ast::ReferenceType>(type)) {
     return refType->getResolvedDecl().getAstNode() ==
            astManager->java_lang.String;
   }
   return false;
 }
 
-// Taken from HierarchyCheck
-static bool isClass(std::shared_ptr<parsetree::ast::AstNode> decl) {
-  return !!std::dynamic_pointer_cast<parsetree::ast::ClassDecl>(decl);
-}
-
-// Taken from HierarchyCheck
-static bool isInterface(std::shared_ptr<parsetree::ast::AstNode> decl) {
-  return !!std::dynamic_pointer_cast<parsetree::ast::InterfaceDecl>(decl);
-}
-
 bool TypeResolver::isSuperClass(
     std::shared_ptr<parsetree::ast::AstNode> super,
     std::shared_ptr<parsetree::ast::AstNode> child) const {
-  if (!child || !super) {
-    return false;
-  }
-  if (!isClass(child)) {
-    return false;
-  }
-  if (!isClass(super)) {
-    return false;
-  }
-  auto childDecl = std::dynamic_pointer_cast<parsetree::ast::ClassDecl>(child);
-  auto superDecl = std::dynamic_pointer_cast<parsetree::ast::ClassDecl>(super);
-
-  for (auto &superClass : childDecl->getSuperClasses()) {
-    if (!superClass || !superClass->getResolvedDecl().getAstNode())
-      continue;
-    // Cast to class
-    auto superClassDecl = std::dynamic_pointer_cast<parsetree::ast::ClassDecl>(
-        superClass->getResolvedDecl().getAstNode());
-
-    if (superClassDecl == superDecl)
-      return true;
-
-    if (isSuperClass(super, std::dynamic_pointer_cast<parsetree::ast::AstNode>(
-                                superClassDecl)))
-      return true;
-  }
-  return false;
+  return astManager->hierarchy.isSuperClass(super, child);
 }
 
-static bool isSuperInterface(std::shared_ptr<parsetree::ast::AstNode> interface,
-                             std::shared_ptr<parsetree::ast::AstNode> child) {
-  if (!child || !interface) {
-    return false;
-  }
-  if (!isClass(child) && !isInterface(child)) {
-    return false;
-  }
-  if (!isInterface(interface)) {
-    return false;
-  }
-  auto interfaceDecl =
-      std::dynamic_pointer_cast<parsetree::ast::InterfaceDecl>(interface);
-  if (isClass(child)) {
-    auto childDecl =
-        std::dynamic_pointer_cast<parsetree::ast::ClassDecl>(child);
-    for (auto &superInterface : childDecl->getInterfaces()) {
-      if (!superInterface || !superInterface->getResolvedDecl().getAstNode())
-        continue;
-      // Cast to class
-      auto superInterfaceDecl =
-          std::dynamic_pointer_cast<parsetree::ast::InterfaceDecl>(
-              superInterface->getResolvedDecl().getAstNode());
-
-      if (superInterfaceDecl == interface)
-        return true;
-      if (isSuperInterface(interface,
-                           std::dynamic_pointer_cast<parsetree::ast::AstNode>(
-                               superInterfaceDecl)))
-        return true;
-    }
-    for (auto &superClass : childDecl->getSuperClasses()) {
-      if (!superClass || !superClass->getResolvedDecl().getAstNode())
-        continue;
-
-      // Cast to class
-      auto superClassDecl =
-          std::dynamic_pointer_cast<parsetree::ast::ClassDecl>(
-              superClass->getResolvedDecl().getAstNode());
-
-      if (isSuperInterface(interface,
-                           std::dynamic_pointer_cast<parsetree::ast::AstNode>(
-                               superClassDecl)))
-        return true;
-    }
-  } else {
-    auto childDecl =
-        std::dynamic_pointer_cast<parsetree::ast::InterfaceDecl>(child);
-    for (auto &superInterface : childDecl->getInterfaces()) {
-      if (!superInterface || !superInterface->getResolvedDecl().getAstNode())
-        continue;
-      // Cast to interface
-      auto superInterfaceDecl =
-          std::dynamic_pointer_cast<parsetree::ast::InterfaceDecl>(
-              superInterface->getResolvedDecl().getAstNode());
-
-      if (superInterfaceDecl == interface)
-        return true;
-      if (isSuperInterface(interface,
-                           std::dynamic_pointer_cast<parsetree::ast::AstNode>(
-                               superInterfaceDecl)))
-        return true;
-    }
-  }
-  return false;
+bool TypeResolver::isSuperInterface(
+    std::shared_ptr<parsetree::ast::AstNode> interface,
+    std::shared_ptr<parsetree::ast::AstNode> child) const {
+  return astManager->hierarchy.isSuperInterface(interface, child);
 }
 
 /**
@@ -215,14 +118,13 @@ bool TypeResolver::isAssignableTo(
   if (*lhs == *rhs)
     return true;
 
-  auto leftPrimitive =
-      std::dynamic_pointer_cast<parsetree::ast::BasicType>(lhs);
+  auto leftPrimitive = parsetree::ast::typeCast<parsetree::ast::BasicType>(lhs);
   auto rightPrimitive =
-      std::dynamic_pointer_cast<parsetree::ast::BasicType>(rhs);
-  auto leftRef = std::dynamic_pointer_cast<parsetree::ast::ReferenceType>(lhs);
-  auto rightRef = std::dynamic_pointer_cast<parsetree::ast::ReferenceType>(rhs);
-  auto leftArr = std::dynamic_pointer_cast<parsetree::ast::ArrayType>(lhs);
-  auto rightArr = std::dynamic_pointer_cast<parsetree::ast::ArrayType>(rhs);
+      parsetree::ast::typeCast<parsetree::ast::BasicType>(rhs);
+  auto leftRef = parsetree::ast::typeCast<parsetree::ast::ReferenceType>(lhs);
+  auto rightRef = parsetree::ast::typeCast<parsetree::ast::ReferenceType>(rhs);
+  auto leftArr = parsetree::ast::typeCast<parsetree::ast::ArrayType>(lhs);
+  auto rightArr = parsetree::ast::typeCast<parsetree::ast::ArrayType>(rhs);
 
   // Identity conversion: Java astManager->java_lang.String <-> primitive
   // astManager->java_lang.String
@@ -294,9 +196,9 @@ bool TypeResolver::isAssignableTo(
   // 3.4 Array assignment rules
   if (rightArr) {
     if (leftArr) {
-      auto leftElem = std::dynamic_pointer_cast<parsetree::ast::ReferenceType>(
+      auto leftElem = parsetree::ast::typeCast<parsetree::ast::ReferenceType>(
           leftArr->getElementType());
-      auto rightElem = std::dynamic_pointer_cast<parsetree::ast::ReferenceType>(
+      auto rightElem = parsetree::ast::typeCast<parsetree::ast::ReferenceType>(
           rightArr->getElementType());
       return leftElem && rightElem && isAssignableTo(leftElem, rightElem);
     }
@@ -335,9 +237,9 @@ bool TypeResolver::isValidCast(
   }
 
   auto exprRef =
-      std::dynamic_pointer_cast<parsetree::ast::ReferenceType>(exprType);
+      parsetree::ast::typeCast<parsetree::ast::ReferenceType>(exprType);
   auto castRef =
-      std::dynamic_pointer_cast<parsetree::ast::ReferenceType>(castType);
+      parsetree::ast::typeCast<parsetree::ast::ReferenceType>(castType);
 
   // null can be cast to any reference type
   if (exprType->isNull())
@@ -345,8 +247,8 @@ bool TypeResolver::isValidCast(
   if (castType->isNull())
     return static_cast<bool>(exprRef);
 
-  auto exprArr = std::dynamic_pointer_cast<parsetree::ast::ArrayType>(exprType);
-  auto castArr = std::dynamic_pointer_cast<parsetree::ast::ArrayType>(castType);
+  auto exprArr = parsetree::ast::typeCast<parsetree::ast::ArrayType>(exprType);
+  auto castArr = parsetree::ast::typeCast<parsetree::ast::ArrayType>(castType);
 
   // If both types are primitive, only numeric type conversions are valid
   if (exprType->isPrimitive() && castType->isPrimitive()) {
@@ -393,9 +295,9 @@ bool TypeResolver::isValidCast(
   if (exprArr) {
     if (castArr) {
       // If both are arrays, check if their element types are castable
-      auto leftElem = std::dynamic_pointer_cast<parsetree::ast::ReferenceType>(
+      auto leftElem = parsetree::ast::typeCast<parsetree::ast::ReferenceType>(
           exprArr->getElementType());
-      auto rightElem = std::dynamic_pointer_cast<parsetree::ast::ReferenceType>(
+      auto rightElem = parsetree::ast::typeCast<parsetree::ast::ReferenceType>(
           castArr->getElementType());
       return leftElem && rightElem &&
              isValidCast(exprArr->getElementType(), castArr->getElementType());
@@ -428,10 +330,8 @@ TypeResolver::mapValue(std::shared_ptr<parsetree::ast::ExprValue> &value) {
     // If the method is a constructor, its return type should be the class it
     // belongs to.
     if (method->isConstructor()) {
-      auto retType = std::make_shared<parsetree::ast::ReferenceType>(
-          method->getParent()->asDecl());
-      retType->setResolvedDecl(Decl{method->getParent()->asDecl()});
-      type->setReturnType(retType);
+      type->setReturnType(
+          astManager->types.getReferenceType(method->getParent()->asDecl()));
     }
     // Return the resolved method type.
     return type;
@@ -452,11 +352,10 @@ void TypeResolver::resolveAST(
   if (auto expr = std::dynamic_pointer_cast<parsetree::ast::Expr>(node)) {
     evaluate(expr);
   } else {
-    for (const auto &child : node->getChildren()) {
-      if (!child)
-        continue;
-      resolveAST(child);
-    }
+    node->forEachChild([&](const auto &child) {
+      if (child)
+        resolveAST(child);
+    });
   }
 }
 
@@ -486,7 +385,7 @@ TypeResolver::evalBinOp(std::shared_ptr<parsetree::ast::BinOp> &op,
   case parsetree::ast::BinOp::OpType::LessThanOrEqual:
     if (lhs->isNumeric() && rhs->isNumeric()) {
       return op->resolveResultType(
-          envManager->BuildBasicType(parsetree::ast::BasicType::Type::Boolean));
+          basicType(parsetree::ast::BasicType::Type::Boolean));
     }
     throw std::runtime_error("comparison operands are non-numeric");
 
@@ -496,18 +395,16 @@ TypeResolver::evalBinOp(std::shared_ptr<parsetree::ast::BinOp> &op,
         (lhs->isBoolean() && rhs->isBoolean()) ||
         (lhs->isString() && rhs->isString())) {
       return op->resolveResultType(
-          envManager->BuildBasicType(parsetree::ast::BasicType::Type::Boolean));
+          basicType(parsetree::ast::BasicType::Type::Boolean));
     }
 
-    auto lhsType =
-        std::dynamic_pointer_cast<parsetree::ast::ReferenceType>(lhs);
-    auto rhsType =
-        std::dynamic_pointer_cast<parsetree::ast::ReferenceType>(rhs);
+    auto lhsType = parsetree::ast::typeCast<parsetree::ast::ReferenceType>(lhs);
+    auto rhsType = parsetree::ast::typeCast<parsetree::ast::ReferenceType>(rhs);
 
     if ((lhs->isNull() || lhsType) && (rhs->isNull() || rhsType) &&
         (isValidCast(lhs, rhs) || isValidCast(rhs, lhs))) {
       return op->resolveResultType(
-          envManager->BuildBasicType(parsetree::ast::BasicType::Type::Boolean));
+          basicType(parsetree::ast::BasicType::Type::Boolean));
     }
     std::cout << "lhs: ";
     lhs->print(std::cout);
@@ -521,11 +418,11 @@ TypeResolver::evalBinOp(std::shared_ptr<parsetree::ast::BinOp> &op,
   case parsetree::ast::BinOp::OpType::Add:
     if (isTypeString(lhs) || isTypeString(rhs)) {
       return op->resolveResultType(
-          envManager->BuildBasicType(parsetree::ast::BasicType::Type::String));
+          basicType(parsetree::ast::BasicType::Type::String));
     }
     if (lhs->isNumeric() && rhs->isNumeric()) {
       return op->resolveResultType(
-          envManager->BuildBasicType(parsetree::ast::BasicType::Type::Int));
+          basicType(parsetree::ast::BasicType::Type::Int));
     }
     throw std::runtime_error("invalid types for arithmetic operation");
 
@@ -535,7 +432,7 @@ TypeResolver::evalBinOp(std::shared_ptr<parsetree::ast::BinOp> &op,
   case parsetree::ast::BinOp::OpType::BitWiseOr:
     if (lhs->isBoolean() && rhs->isBoolean()) {
       return op->resolveResultType(
-          envManager->BuildBasicType(parsetree::ast::BasicType::Type::Boolean));
+          basicType(parsetree::ast::BasicType::Type::Boolean));
     }
     throw std::runtime_error("logical operation requires boolean operands");
 
@@ -547,7 +444,7 @@ TypeResolver::evalBinOp(std::shared_ptr<parsetree::ast::BinOp> &op,
   case parsetree::ast::BinOp::OpType::Modulo: {
     if (lhs->isNumeric() && rhs->isNumeric()) {
       return op->resolveResultType(
-          envManager->BuildBasicType(parsetree::ast::BasicType::Type::Int));
+          basicType(parsetree::ast::BasicType::Type::Int));
     }
     throw std::runtime_error("invalid types for arithmetic operation");
   }
@@ -558,7 +455,7 @@ TypeResolver::evalBinOp(std::shared_ptr<parsetree::ast::BinOp> &op,
       // op->setLhsType(lhs);
       // op->setRhsType(rhs);
       return op->resolveResultType(
-          envManager->BuildBasicType(parsetree::ast::BasicType::Type::Boolean));
+          basicType(parsetree::ast::BasicType::Type::Boolean));
     }
   }
 
@@ -580,13 +477,13 @@ TypeResolver::evalUnOp(std::shared_ptr<parsetree::ast::UnOp> &op,
     // case parsetree::ast::UnOp::OpType::BitWiseNot:
     if (rhs->isNumeric()) {
       return op->resolveResultType(
-          envManager->BuildBasicType(parsetree::ast::BasicType::Type::Int));
+          basicType(parsetree::ast::BasicType::Type::Int));
     }
     break;
   case parsetree::ast::UnOp::OpType::Not:
     if (rhs->isBoolean()) {
       return op->resolveResultType(
-          envManager->BuildBasicType(parsetree::ast::BasicType::Type::Boolean));
+          basicType(parsetree::ast::BasicType::Type::Boolean));
     }
     break;
   default:
@@ -619,7 +516,7 @@ std::shared_ptr<parsetree::ast::Type> TypeResolver::evalMethodInvocation(
   }
 
   auto methodType =
-      std::dynamic_pointer_cast<parsetree::ast::MethodType>(method);
+      parsetree::ast::typeCast<parsetree::ast::MethodType>(method);
   if (!methodType) {
     throw std::runtime_error("Not a method type");
   }
@@ -652,7 +549,7 @@ std::shared_ptr<parsetree::ast::Type> TypeResolver::evalNewObject(
 
   // Ensure the provided object type is actually a method type (constructor).
   auto constructor =
-      std::dynamic_pointer_cast<parsetree::ast::MethodType>(object);
+      parsetree::ast::typeCast<parsetree::ast::MethodType>(object);
   if (!constructor) {
     throw std::runtime_error("Not a method type");
   }
@@ -705,7 +602,7 @@ std::shared_ptr<parsetree::ast::Type> TypeResolver::evalArrayAccess(
     return result;
   }
 
-  auto arrayType = std::dynamic_pointer_cast<parsetree::ast::ArrayType>(array);
+  auto arrayType = parsetree::ast::typeCast<parsetree::ast::ArrayType>(array);
   if (!arrayType) {
     throw std::runtime_error("Not an array type");
   }
@@ -0,0 +1,183 @@
+#include "utils/timeReport.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sys/resource.h>
+
+namespace {
+
+// Only set while a TimeReport is alive, so without --time-report an
+// allocation is a plain malloc and threads don't share the counter
+std::atomic<bool> countAllocations = false;
+std::atomic<uint64_t> totalAllocations = 0;
+thread_local uint64_t threadAllocations = 0;
+
+int64_t nowNs(clockid_t clock) {
+  timespec ts;
+  clock_gettime(clock, &ts);
+  return static_cast<int64_t>(ts.tv_sec) * 1'000'000'000 + ts.tv_nsec;
+}
+
+long peakRssKb() {
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss; // kilobytes on Linux
+}
+
+void countAllocation() {
+  if (!countAllocations.load(std::memory_order_relaxed))
+    return;
+  totalAllocations.fetch_add(1, std::memory_order_relaxed);
+  ++threadAllocations;
+}
+
+void writeJsonString(std::ostream &os, const std::string &str) {
+  os << '"';
+  for (char c : str) {
+    if (c == '"' || c == '\\') {
+      os << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char buf[8];
+      std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+      os << buf;
+    } else {
+      os << c;
+    }
+  }
+  os << '"';
+}
+
+} // namespace
+
+// Counting replacements of the global allocation functions. The array and
+// nothrow forms forward to these in libstdc++.
+void *operator new(std::size_t size) {
+  countAllocation();
+  if (void *ptr = std::malloc(size ? size : 1))
+    return ptr;
+  throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, std::align_val_t align) {
+  countAllocation();
+  auto alignment = static_cast<std::size_t>(align);
+  size = (size + alignment - 1) / alignment * alignment;
+  if (void *ptr = std::aligned_alloc(alignment, size ? size : alignment))
+    return ptr;
+  throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept {
+  std::free(ptr);
+}
+
+namespace utils {
+
+TimeReport::TimeReport(Format format) : format{format} {
+  current = this;
+  countAllocations.store(true, std::memory_order_relaxed);
+}
+
+TimeReport::~TimeReport() {
+  current = nullptr;
+  countAllocations.store(false, std::memory_order_relaxed);
+  if (format == Format::Json)
+    printJson(std::cerr);
+  else
+    print(std::cerr);
+}
+
+void TimeReport::add(Entry entry) {
+  std::lock_guard lock{mutex};
+  entries.push_back(std::move(entry));
+}
+
+void TimeReport::print(std::ostream &os) const {
+  std::lock_guard lock{mutex};
+  os << "===== time report =====\n";
+  os << std::left << std::setw(28) << "phase" << std::right << std::setw(12)
+     << "wall (ms)" << std::setw(12) << "cpu (ms)" << std::setw(14)
+     << "peak rss (kb)" << std::setw(14) << "allocations" << "\n";
+  auto flags = os.flags();
+  os << std::fixed << std::setprecision(2);
+  // whole phases, each followed by its units
+  for (const auto &entry : entries) {
+    if (!entry.unit.empty())
+      continue;
+    os << std::left << std::setw(28) << entry.phase << std::right
+       << std::setw(12) << entry.wallMs << std::setw(12) << entry.cpuMs
+       << std::setw(14) << entry.peakRssKb << std::setw(14)
+       << entry.allocations << "\n";
+    for (const auto &unit : entries) {
+      if (unit.unit.empty() || unit.phase != entry.phase)
+        continue;
+      os << "  " << std::left << std::setw(26) << unit.unit << std::right
+         << std::setw(12) << unit.wallMs << std::setw(12) << unit.cpuMs
+         << std::setw(14) << unit.peakRssKb << std::setw(14)
+         << unit.allocations << "\n";
+    }
+  }
+  os.flags(flags);
+}
+
+void TimeReport::printJson(std::ostream &os) const {
+  std::lock_guard lock{mutex};
+  os << "{\"phases\": [";
+  bool first = true;
+  for (const auto &entry : entries) {
+    os << (first ? "\n" : ",\n") << "  {\"phase\": ";
+    first = false;
+    writeJsonString(os, entry.phase);
+    if (!entry.unit.empty()) {
+      os << ", \"unit\": ";
+      writeJsonString(os, entry.unit);
+    }
+    os << ", \"wall_ms\": " << entry.wallMs << ", \"cpu_ms\": " << entry.cpuMs
+       << ", \"peak_rss_kb\": " << entry.peakRssKb
+       << ", \"allocations\": " << entry.allocations << "}";
+  }
+  os << "\n]}\n";
+}
+
+uint64_t TimeReport::allocationCount() {
+  return totalAllocations.load(std::memory_order_relaxed);
+}
+
+uint64_t TimeReport::threadAllocationCount() { return threadAllocations; }
+
+TimeReport::Scope::Scope(std::string phase, std::string unit)
+    : report{TimeReport::active()}, phase{std::move(phase)},
+      unit{std::move(unit)} {
+  if (!report)
+    return;
+  const bool perThread = !this->unit.empty();
+  wallStart = nowNs(CLOCK_MONOTONIC);
+  cpuStart = nowNs(perThread ? CLOCK_THREAD_CPUTIME_ID
+                             : CLOCK_PROCESS_CPUTIME_ID);
+  allocStart = perThread ? threadAllocationCount() : allocationCount();
+}
+
+void TimeReport::Scope::stop() {
+  if (!report)
+    return;
+  const bool perThread = !unit.empty();
+  const int64_t wall = nowNs(CLOCK_MONOTONIC) - wallStart;
+  const int64_t cpu =
+      nowNs(perThread ? CLOCK_THREAD_CPUTIME_ID : CLOCK_PROCESS_CPUTIME_ID) -
+      cpuStart;
+  const uint64_t allocs =
+      (perThread ? threadAllocationCount() : allocationCount()) - allocStart;
+  report->add(Entry{std::move(phase), std::move(unit), wall / 1e6, cpu / 1e6,
+                    peakRssKb(), allocs});
+  report = nullptr;
+}
+
+} // namespace utils